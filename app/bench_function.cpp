@@ -8,7 +8,7 @@
 
 using namespace nano;
 
-static void eval_func(const function_t& function, table_t& table)
+static void eval_func(const function_t& function, const tensor_size_t batch, table_t& table)
 {
     const auto dims = function.size();
     const vector_t x = vector_t::Zero(dims);
@@ -29,14 +29,31 @@ static void eval_func(const function_t& function, table_t& table)
         gx += g.template lpNorm<Eigen::Infinity>();
     }, trials).count();
 
+    // NB: the batched evaluations are reported per point to be comparable with the single point evaluations
+    const matrix_t X = matrix_t::Zero(batch, dims);
+    vector_t fX = vector_t::Zero(batch);
+    matrix_t G = matrix_t::Zero(batch, dims);
+
+    const auto fvals_time = measure<nanoseconds_t>([&] ()
+    {
+        function.vgrads(X, fX);
+        fx += fX.sum();
+    }, trials).count() / batch;
+
+    const auto grads_time = measure<nanoseconds_t>([&] ()
+    {
+        function.vgrads(X, fX, &G);
+        gx += G.template lpNorm<Eigen::Infinity>();
+    }, trials).count() / batch;
+
     scalar_t grad_accuracy = 0;
     for (size_t i = 0; i < trials; ++ i)
     {
-        grad_accuracy += function.grad_accuracy(vector_t::Random(dims));
+        grad_accuracy += function.grad_accuracy(vector_t::Random(dims), 0, execution::par);
     }
 
     auto& row = table.append();
-    row << function.name() << fval_time << grad_time
+    row << function.name() << fval_time << grad_time << fvals_time << grads_time
         << scat(std::setprecision(12), std::fixed, grad_accuracy / static_cast<scalar_t>(trials));
 }
 
@@ -47,6 +64,7 @@ static int unsafe_main(int argc, const char* argv[])
     cmdline.add("", "min-dims",     "minimum number of dimensions for each test function (if feasible)", "1024");
     cmdline.add("", "max-dims",     "maximum number of dimensions for each test function (if feasible)", "1024");
     cmdline.add("", "functions",    "use this regex to select the functions to benchmark", ".+");
+    cmdline.add("", "batch",        "number of points to evaluate at once (batched evaluation)", "32");
 
     cmdline.process(argc, argv);
 
@@ -60,9 +78,12 @@ static int unsafe_main(int argc, const char* argv[])
     const auto min_dims = cmdline.get<tensor_size_t>("min-dims");
     const auto max_dims = cmdline.get<tensor_size_t>("max-dims");
     const auto functions = std::regex(cmdline.get<string_t>("functions"));
+    const auto batch = cmdline.get<tensor_size_t>("batch");
+
+    critical(batch < 1, scat("invalid number of points to evaluate at once (", batch, ")!"));
 
     table_t table;
-    table.header() << "function" << "f(x)[ns]" << "f(x,g)[ns]" << "grad accuracy";
+    table.header() << "function" << "f(x)[ns]" << "f(x,g)[ns]" << "f(X)[ns/x]" << "f(X,G)[ns/x]" << "grad accuracy";
     table.delim();
 
     tensor_size_t prev_size = min_dims;
@@ -73,7 +94,7 @@ static int unsafe_main(int argc, const char* argv[])
             table.delim();
             prev_size = function->size();
         }
-        eval_func(*function, table);
+        eval_func(*function, batch, table);
     }
 
     std::cout << table;
@@ -1,3 +1,4 @@
+#include <iomanip>
 #include <nano/table.h>
 #include <nano/chrono.h>
 #include <nano/logger.h>
@@ -131,6 +132,96 @@ static auto tune_batch(const dataset_t& dataset)
 }
 */
 
+static auto make_dataset(const string_t& id)
+{
+    const auto start = nano::timer_t{};
+
+    auto dataset = dataset_t::all().get(id);
+    critical(!dataset, scat("invalid dataset '", id, "'"));
+    dataset->load();
+
+    log_info() << ">>> loading done in " << start.elapsed() << ".";
+    return dataset;
+}
+
+static bool is_imclass(const string_t& id)
+{
+    const auto dataset = dataset_t::all().get(id);
+    return dynamic_cast<const imclass_dataset_t*>(dataset.get()) != nullptr;
+}
+
+static auto make_solver(const string_t& id, const scalar_t epsilon, const int max_iterations)
+{
+    auto solver = solver_t::all().get(id);
+    critical(!solver, scat("invalid solver '", id, "'"));
+    solver->epsilon(epsilon);
+    solver->max_iterations(max_iterations);
+    return solver;
+}
+
+static auto evaluate(const loss_t& loss, const dataset_t& dataset, const indices_t& samples, const model_t& model)
+{
+    const auto outputs = model.predict(dataset, samples);
+    const auto targets = dataset.targets(samples);
+
+    tensor1d_t errors(samples.size());
+    loss.error(targets, outputs, errors);
+    return errors.vector().mean();
+}
+
+static void bench_precision(
+    const string_t& dataset_id, const dataset_t& dataset, const string_t& solver_id, solver_t& solver,
+    const string_t& loss_id, const loss_t& loss, normalization normalization, precision precision,
+    bool training, table_t& table)
+{
+    const auto tr_samples = dataset.train_samples();
+    const auto te_samples = dataset.test_samples();
+
+    auto function = linear_function_t{loss, dataset, tr_samples, normalization, precision};
+
+    volatile scalar_t fx = 0;
+    vector_t gx(function.size());
+    const vector_t x = vector_t::Random(function.size());
+    const auto vgrad_time = measure<microseconds_t>([&] () { fx = function.vgrad(x, &gx); }, 10).count();
+
+    auto& row = table.append();
+    row << dataset_id << solver_id << loss_id << scat(normalization) << scat(precision)
+        << scat(std::fixed, std::setprecision(1), 1e-3 * static_cast<scalar_t>(vgrad_time));
+
+    if (!training)
+    {
+        row << "-" << "-" << "-" << "-" << "-" << "-" << "-";
+        return;
+    }
+
+    // NB: keep track of the last optimization state to break down the training time
+    auto state = solver_state_t{};
+    solver.logger([&] (const solver_state_t& cstate)
+    {
+        state = cstate;
+        return true;
+    });
+
+    auto model = linear_model_t{};
+    model.normalization(normalization);
+    model.precision(precision);
+
+    const auto start = nano::timer_t{};
+    model.fit(loss, dataset, tr_samples, solver);
+    const auto train_time = start.milliseconds().count();
+
+    solver.logger({});
+
+    row << train_time
+        << scat(std::fixed, std::setprecision(1), 1e-6 * static_cast<scalar_t>(state.m_ftime))
+        << scat(std::fixed, std::setprecision(1), 1e-6 * static_cast<scalar_t>(state.m_ltime))
+        << scat(std::fixed, std::setprecision(1), 1e-6 * static_cast<scalar_t>(state.m_dtime))
+        << scat(std::fixed, std::setprecision(2),
+            static_cast<scalar_t>(state.m_fbytes) / std::max(static_cast<scalar_t>(state.m_ftime), scalar_t(1)))
+        << scat(std::fixed, std::setprecision(4), evaluate(loss, dataset, tr_samples, model))
+        << scat(std::fixed, std::setprecision(4), evaluate(loss, dataset, te_samples, model));
+}
+
 static int unsafe_main(int argc, const char* argv[])
 {
     // parse the command line
@@ -140,6 +231,7 @@ static int unsafe_main(int argc, const char* argv[])
     cmdline.add("", "loss",             "regex to select the loss functions to benchmark", "s-classnll");
     cmdline.add("", "normalization",    "regex to select the feature scaling methods to benchmark", ".+");
     cmdline.add("", "regularization",   "regex to select the regularization methods to benchmark", ".+");
+    cmdline.add("", "precision",        "regex to select the floating point precisions to benchmark", ".+");
     cmdline.add("", "epsilon",          "convergence criterion (solver)", 1e-3);
     cmdline.add("", "max-iterations",   "maximum number of iterations (solver)", 1000);
     cmdline.add("", "tune-trials",      "maximum number of trials per tuning step of the regularization factor", 7);
@@ -158,6 +250,53 @@ static int unsafe_main(int argc, const char* argv[])
         return EXIT_SUCCESS;
     }
 
+    const auto epsilon = cmdline.get<scalar_t>("epsilon");
+    const auto max_iterations = cmdline.get<int>("max-iterations");
+    const auto training = !cmdline.has("no-training");
+    const auto precisions = enum_values<precision>(std::regex(cmdline.get<string_t>("precision")));
+    const auto normalizations = enum_values<normalization>(std::regex(cmdline.get<string_t>("normalization")));
+
+    table_t table;
+    table.header()
+        << "dataset" << "solver" << "loss" << "normalization" << "precision"
+        << "vgrad[ms]" << "train[ms]" << "f,g[ms]" << "lsearch[ms]" << "descent[ms]" << "GB/s"
+        << "train error" << "test error";
+
+    // compare the throughput and the final error for each floating point precision
+    for (const auto& dataset_id : dataset_t::all().ids(std::regex(cmdline.get<string_t>("imclass"))))
+    {
+        // NB: skip the other (e.g. tabular) datasets, as they may have categorical or missing feature values
+        if (!is_imclass(dataset_id))
+        {
+            continue;
+        }
+
+        const auto dataset = make_dataset(dataset_id);
+
+        for (const auto& solver_id : solver_t::all().ids(std::regex(cmdline.get<string_t>("solver"))))
+        {
+            const auto solver = make_solver(solver_id, epsilon, max_iterations);
+
+            for (const auto& loss_id : loss_t::all().ids(std::regex(cmdline.get<string_t>("loss"))))
+            {
+                const auto loss = loss_t::all().get(loss_id);
+
+                table.delim();
+                for (const auto normalization : normalizations)
+                {
+                    for (const auto precision : precisions)
+                    {
+                        bench_precision(
+                            dataset_id, *dataset, solver_id, *solver, loss_id, *loss,
+                            normalization, precision, training, table);
+                    }
+                }
+            }
+        }
+    }
+
+    std::cout << table;
+
     /*
     const auto folds = cmdline.get<size_t>("folds");
     const auto epsilon = cmdline.get<scalar_t>("epsilon");
@@ -21,7 +21,14 @@ struct solver_stat_t
         m_maxits(state.m_status == solver_state_t::status::max_iters ? 1 : 0);
         m_fcalls(static_cast<scalar_t>(state.m_fcalls));
         m_gcalls(static_cast<scalar_t>(state.m_gcalls));
-        m_costs(static_cast<scalar_t>(state.m_fcalls + 2 * state.m_gcalls));
+        m_hcalls(static_cast<scalar_t>(state.m_hcalls));
+        m_hits(static_cast<scalar_t>(state.m_hits));
+        m_costs(static_cast<scalar_t>(state.m_fcalls + 2 * state.m_gcalls + 2 * state.m_hcalls));
+        m_ftimes(1e-3 * static_cast<scalar_t>(state.m_ftime));
+        m_ltimes(1e-3 * static_cast<scalar_t>(state.m_ltime));
+        m_dtimes(1e-3 * static_cast<scalar_t>(state.m_dtime));
+        m_bandwidths(
+            static_cast<scalar_t>(state.m_fbytes) / std::max(static_cast<scalar_t>(state.m_ftime), scalar_t(1)));
     }
 
     stats_t     m_crits;            ///< convergence criterion
@@ -31,7 +38,13 @@ struct solver_stat_t
     stats_t     m_maxits;           ///< #maximum iterations reached
     stats_t     m_fcalls;           ///< #function value calls
     stats_t     m_gcalls;           ///< #gradient calls
-    stats_t     m_costs;            ///< computation cost as a function of function value and gradient calls
+    stats_t     m_hcalls;           ///< #Hessian-vector product calls
+    stats_t     m_costs;            ///< computation cost as a function of all the calls above
+    stats_t     m_hits;             ///< #function calls served from the cache (not included in the cost)
+    stats_t     m_ftimes;           ///< time spent evaluating the function [us]
+    stats_t     m_ltimes;           ///< time spent in line-search [us]
+    stats_t     m_dtimes;           ///< time spent updating the descent direction [us]
+    stats_t     m_bandwidths;       ///< memory bandwidth of the function evaluations [GB/s]
     int64_t     m_milliseconds{0};  ///< total number of milliseconds
 };
 
@@ -56,8 +69,14 @@ static void show_table(const string_t& table_name, const solver_config_stats_t&
         << "#maxits"
         << "#fcalls"
         << "#gcalls"
+        << "#hcalls"
         << "cost"
-        << "[ms]";
+        << "#saved"
+        << "[ms]"
+        << "f,g[us]"
+        << "lsearch[us]"
+        << "descent[us]"
+        << "GB/s";
     table.delim();
 
     for (const auto& it : stats)
@@ -75,12 +94,18 @@ static void show_table(const string_t& table_name, const solver_config_stats_t&
             << static_cast<size_t>(stat.m_maxits.sum1())
             << static_cast<size_t>(stat.m_fcalls.avg())
             << static_cast<size_t>(stat.m_gcalls.avg())
+            << static_cast<size_t>(stat.m_hcalls.avg())
             << static_cast<size_t>(stat.m_costs.avg())
-            << stat.m_milliseconds;
+            << static_cast<size_t>(stat.m_hits.sum1())
+            << stat.m_milliseconds
+            << scat(std::fixed, std::setprecision(1), stat.m_ftimes.avg())
+            << scat(std::fixed, std::setprecision(1), stat.m_ltimes.avg())
+            << scat(std::fixed, std::setprecision(1), stat.m_dtimes.avg())
+            << scat(std::fixed, std::setprecision(2), stat.m_bandwidths.avg());
         }
     }
 
-    table.sort(nano::make_less_from_string<scalar_t>(), {4, 10});
+    table.sort(nano::make_less_from_string<scalar_t>(), {4, 11});
     std::cout << table;
 }
 
@@ -97,7 +122,7 @@ static auto log_solver(const function_t& function, const rsolver_t& solver, cons
     {
         std::cout
             << "descent: i=" << state.m_iterations << ",f=" << state.f << ",g=" << state.convergence_criterion()
-            << "[" << state.m_status << "]" << ",calls=" << state.m_fcalls << "/" << state.m_gcalls << "." << std::endl;
+            << "[" << state.m_status << "]" << ",calls=" << state.m_fcalls << "/" << state.m_gcalls << "/" << state.m_hcalls << "." << std::endl;
         return true;
     });
 
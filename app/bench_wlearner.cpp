@@ -0,0 +1,94 @@
+#include <iomanip>
+#include <nano/table.h>
+#include <nano/chrono.h>
+#include <nano/logger.h>
+#include <nano/cmdline.h>
+#include <nano/dataset/synth_affine.h>
+#include <nano/gboost/wlearner_dtree.h>
+
+using namespace nano;
+
+static auto make_dataset(const cmdline_t& cmdline)
+{
+    auto dataset = synthetic_affine_dataset_t{};
+    dataset.noise(0.1);
+    dataset.modulo(1);
+    dataset.samples(cmdline.get<tensor_size_t>("samples"));
+    dataset.idim(make_dims(cmdline.get<tensor_size_t>("features"), 1, 1));
+    dataset.tdim(make_dims(cmdline.get<tensor_size_t>("outputs"), 1, 1));
+    dataset.load();
+    return dataset;
+}
+
+static void eval_dtree(const dataset_t& dataset, const indices_t& samples, const tensor4d_t& gradients,
+    const int max_depth, const size_t trials, table_t& table)
+{
+    auto wlearner = wlearner_dtree_t{};
+    wlearner.min_split(1);
+    wlearner.max_depth(max_depth);
+
+    volatile scalar_t score = 0;
+    const auto fit_time = measure<microseconds_t>([&] ()
+    {
+        score += wlearner.fit(dataset, samples, gradients);
+    }, trials).count();
+
+    auto& row = table.append();
+    row << max_depth << wlearner.nodes().size() << wlearner.tables().size<0>()
+        << scat(std::setprecision(3), std::fixed, static_cast<scalar_t>(fit_time) * 1e-3);
+}
+
+static int unsafe_main(int argc, const char* argv[])
+{
+    // parse the command line
+    cmdline_t cmdline("benchmark fitting weak learners on synthetic datasets");
+    cmdline.add("", "samples",      "number of samples", "10000");
+    cmdline.add("", "features",     "number of (continuous) features", "10");
+    cmdline.add("", "outputs",      "number of outputs", "10");
+    cmdline.add("", "min-depth",    "dtree: minimum depth to evaluate", "1");
+    cmdline.add("", "max-depth",    "dtree: maximum depth to evaluate", "10");
+    cmdline.add("", "trials",       "number of times to repeat the measurements", "3");
+
+    cmdline.process(argc, argv);
+
+    if (cmdline.has("help"))
+    {
+        cmdline.usage();
+        return EXIT_SUCCESS;
+    }
+
+    // check arguments and options
+    const auto min_depth = cmdline.get<int>("min-depth");
+    const auto max_depth = cmdline.get<int>("max-depth");
+    const auto trials = cmdline.get<size_t>("trials");
+
+    // NB: the maximum depth is checked when configuring the weak learner (@see wlearner_dtree_t::max_depth)
+    critical(
+        min_depth < 1 || min_depth > max_depth,
+        scat("invalid depth range [", min_depth, ", ", max_depth, "]!"));
+
+    const auto dataset = make_dataset(cmdline);
+    const auto samples = dataset.train_samples();
+
+    tensor4d_t gradients(cat_dims(dataset.samples(), dataset.tdim()));
+    gradients.random();
+
+    table_t table;
+    table.header() << "max depth" << "nodes" << "tables" << "fit[ms]";
+    table.delim();
+
+    for (auto depth = min_depth; depth <= max_depth; ++ depth)
+    {
+        eval_dtree(dataset, samples, gradients, depth, trials, table);
+    }
+
+    std::cout << table;
+
+    // OK
+    return EXIT_SUCCESS;
+}
+
+int main(int argc, const char* argv[])
+{
+    return nano::main(unsafe_main, argc, argv);
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <nano/mlearn/enums.h>
+#include <nano/dataset/sparse.h>
+
+namespace nano
+{
+    ///
+    /// \brief sparse dataset loaded from a text file in the libsvm format:
+    ///     <label>[,<label>...] <feature index>:<feature value> <feature index>:<feature value> ...
+    ///
+    /// NB: the feature indices are one-based and the trailing comments (starting with #) are ignored.
+    /// NB: the labels are parsed as:
+    ///     - a scalar value for regression tasks,
+    ///     - a class label for single-label classification tasks,
+    ///     - a comma-separated list of class labels for multi-label classification tasks.
+    ///
+    /// NB: the feature indices are hashed (modulo) into the given number of features (if positive),
+    ///     otherwise the number of features is given by the maximum feature index.
+    ///     The values of the feature indices mapped to the same hashed feature are summed.
+    ///
+    class NANO_PUBLIC libsvm_dataset_t : public sparse_dataset_t
+    {
+    public:
+
+        ///
+        /// \brief default constructor
+        ///
+        libsvm_dataset_t() = default;
+
+        ///
+        /// \brief constructor, set the file to load.
+        ///
+        explicit libsvm_dataset_t(string_t path, task_type = task_type::sclassification, tensor_size_t features = 0);
+
+        ///
+        /// \brief @see dataset_t
+        ///
+        void load() override;
+
+        ///
+        /// \brief access functions
+        ///
+        const auto& path() const { return m_path; }
+        auto task() const { return m_task; }
+
+    private:
+
+        // attributes
+        string_t        m_path;                                 ///<
+        task_type       m_task{task_type::sclassification};     ///<
+        tensor_size_t   m_features{0};                          ///< number of (hashed) features (if positive)
+    };
+}
@@ -10,6 +10,10 @@ namespace nano
     /// NB: this is useful for estimating the importance of a feature by measuring
     ///     the difference in accuracy when the associated feature values are shuffled (across samples).
     ///
+    /// NB: the feature values are either shuffled at each call (within the requested samples)
+    ///     or permuted using a fixed permutation of all samples given at construction
+    ///     (thus consistent across calls, e.g. when processing batches of samples).
+    ///
     class shuffle_dataset_t : public dataset_t
     {
     public:
@@ -24,6 +28,19 @@ namespace nano
             assert(feature2shuffle >= 0 && feature2shuffle < m_source.features());
         }
 
+        ///
+        /// \brief constructor with a fixed permutation of all samples:
+        ///     the feature value of the sample `s` is taken from the sample `permutation(s)`.
+        ///
+        shuffle_dataset_t(const dataset_t& source, tensor_size_t feature2shuffle, indices_t permutation) :
+            m_source(source),
+            m_feature2shuffle(feature2shuffle),
+            m_permutation(std::move(permutation))
+        {
+            assert(feature2shuffle >= 0 && feature2shuffle < m_source.features());
+            assert(m_permutation.size() == m_source.samples());
+        }
+
         ///
         /// \brief @see dataset_t
         ///
@@ -61,7 +78,7 @@ namespace nano
         tensor4d_t inputs(const indices_cmap_t& samples) const override
         {
             auto inputs = m_source.inputs(samples);
-            shuffle(inputs, m_feature2shuffle);
+            shuffle(samples, inputs, m_feature2shuffle);
             return inputs;
         }
 
@@ -73,7 +90,7 @@ namespace nano
             auto inputs = m_source.inputs(samples, feature);
             if (m_feature2shuffle == feature)
             {
-                shuffle(inputs, 0);
+                shuffle(samples, inputs, 0);
             }
             return inputs;
         }
@@ -87,7 +104,7 @@ namespace nano
             const auto* const it = std::find(features.begin(), features.end(), m_feature2shuffle);
             if (it != features.end())
             {
-                shuffle(inputs, std::distance(features.begin(), it));
+                shuffle(samples, inputs, std::distance(features.begin(), it));
             }
             return inputs;
         }
@@ -121,11 +138,27 @@ namespace nano
     private:
 
         template <typename ttensor>
-        void shuffle(ttensor& inputs, tensor_size_t col) const
+        void shuffle(const indices_cmap_t& samples, ttensor& inputs, tensor_size_t col) const
         {
             auto matrix = inputs.reshape(inputs.template size<0>(), -1);
             assert(col >= 0 && col < matrix.cols());
 
+            if (m_permutation.size() > 0)
+            {
+                indices_t psamples(samples.size());
+                for (tensor_size_t i = 0; i < samples.size(); ++ i)
+                {
+                    psamples(i) = m_permutation(samples(i));
+                }
+
+                const auto values = m_source.inputs(psamples, m_feature2shuffle);
+                for (tensor_size_t i = 0; i < samples.size(); ++ i)
+                {
+                    matrix(i, col) = values(i);
+                }
+                return;
+            }
+
             auto&& rng = ::nano::make_rng();
             using diff_t = tensor_size_t;
             using dist_t = std::uniform_int_distribution<diff_t>;
@@ -142,5 +175,6 @@ namespace nano
         // attributes
         const dataset_t&    m_source;               ///< original dataset
         tensor_size_t       m_feature2shuffle{0};   ///< feature index to shuffle (across samples)
+        indices_t           m_permutation;          ///< optional fixed permutation of all samples
     };
 }
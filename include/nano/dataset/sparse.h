@@ -0,0 +1,121 @@
+#pragma once
+
+#include <nano/dataset.h>
+
+namespace nano
+{
+    ///
+    /// \brief in-memory dataset consisting of sparse inputs with targets,
+    ///     where the inputs are stored in the compressed sparse row (CSR) format:
+    ///     - the feature indices of the i-th sample are stored in findices()[offsets()(i), offsets()(i + 1))
+    ///         (sorted in increasing order) and
+    ///     - the associated feature values are stored in fvalues()[offsets()(i), offsets()(i + 1)).
+    ///
+    /// NB: this is useful for high-dimensional datasets with mostly zero feature values
+    ///     (e.g. with hashed categorical features), that would not fit in memory if stored densely.
+    ///
+    /// NB: the dense inputs (@see dataset_t::inputs) are materialized only for the requested samples.
+    ///
+    class NANO_PUBLIC sparse_dataset_t : public dataset_t
+    {
+    public:
+
+        using dataset_t::target;
+
+        ///
+        /// \brief default constructor
+        ///
+        sparse_dataset_t() = default;
+
+        ///
+        /// \brief constructor, set the inputs (in CSR format) and the targets.
+        ///
+        sparse_dataset_t(
+            indices_t offsets, indices_t findices, tensor1d_t fvalues, tensor_size_t features,
+            tensor4d_t targets, feature_t target = feature_t{"target"});
+
+        ///
+        /// \brief @see dataset_t
+        ///
+        void load() override;
+
+        ///
+        /// \brief @see dataset_t
+        ///
+        tensor_size_t samples() const override { return m_targets.size<0>(); }
+
+        ///
+        /// \brief @see dataset_t
+        ///
+        tensor3d_dim_t idim() const override { return make_dims(m_features, 1, 1); }
+
+        ///
+        /// \brief @see dataset_t
+        ///
+        tensor3d_dim_t tdim() const override
+        {
+            return make_dims(m_targets.size<1>(), m_targets.size<2>(), m_targets.size<3>());
+        }
+
+        ///
+        /// \brief @see dataset_t
+        ///
+        feature_t target() const override { return m_target; }
+
+        ///
+        /// \brief @see dataset_t
+        ///
+        feature_t feature(tensor_size_t index) const override;
+
+        ///
+        /// \brief @see dataset_t
+        ///
+        tensor4d_t inputs(const indices_cmap_t& samples) const override;
+
+        ///
+        /// \brief @see dataset_t
+        ///
+        tensor1d_t inputs(const indices_cmap_t& samples, tensor_size_t feature) const override;
+
+        ///
+        /// \brief @see dataset_t
+        ///
+        tensor2d_t inputs(const indices_cmap_t& samples, const indices_t& features) const override;
+
+        ///
+        /// \brief @see dataset_t
+        ///
+        tensor4d_t targets(const indices_cmap_t& samples) const override;
+
+        ///
+        /// \brief returns the inputs as stored in the CSR format.
+        ///
+        const auto& offsets() const { return m_offsets; }
+        const auto& findices() const { return m_findices; }
+        const auto& fvalues() const { return m_fvalues; }
+
+        ///
+        /// \brief returns the number of stored (non-zero) feature values.
+        ///
+        tensor_size_t nonzeros() const { return m_fvalues.size(); }
+
+    protected:
+
+        ///
+        /// \brief set the inputs (in CSR format) and the targets.
+        ///
+        void store(
+            indices_t offsets, indices_t findices, tensor1d_t fvalues, tensor_size_t features,
+            tensor4d_t targets, feature_t target);
+
+    private:
+
+        // attributes
+        indices_t       m_offsets;      ///< (#samples + 1,) - offsets of the samples in the feature indices and values
+        indices_t       m_findices;     ///< (#non-zeros,) - feature indices
+        tensor1d_t      m_fvalues;      ///< (#non-zeros,) - feature values
+        tensor_size_t   m_features{0};  ///< total number of features
+        tensor4d_t      m_targets;      ///< (total number of samples, #tdim1, #tdim2, #tdim3)
+        feature_t       m_target;       ///<
+    };
+}
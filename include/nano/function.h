@@ -5,6 +5,7 @@
 #include <nano/arch.h>
 #include <nano/tensor.h>
 #include <nano/string.h>
+#include <nano/mlearn/enums.h>
 
 namespace nano
 {
@@ -70,9 +71,15 @@ namespace nano
         tensor_size_t size() const { return m_size; }
 
         ///
-        /// \brief compute the gradient accuracy (given vs. central finite difference approximation)
+        /// \brief compute the gradient accuracy (given vs. central finite difference approximation).
         ///
-        scalar_t grad_accuracy(const vector_t& x) const;
+        /// NB: if the number of directions is zero, then the gradient is approximated along each coordinate,
+        ///     otherwise the directional derivatives are checked along the given number of random directions
+        ///     (recommended for functions with many dimensions).
+        /// NB: the function is evaluated concurrently on the thread pool only if requested with execution::par,
+        ///     which is safe only for functions without mutable state (e.g. not @see solver_function_t).
+        ///
+        scalar_t grad_accuracy(const vector_t& x, tensor_size_t directions = 0, execution = execution::seq) const;
 
         ///
         /// \brief check if the function is convex along the [x1, x2] line
@@ -87,8 +94,59 @@ namespace nano
         ///
         /// \brief evaluate the function's value at the give point (and its gradient if provided).
         ///
+        /// NB: the function may be evaluated concurrently from multiple threads if requested (e.g. @see grad_accuracy).
+        ///
         virtual scalar_t vgrad(const vector_t& x, vector_t* gx = nullptr) const = 0;
 
+        ///
+        /// \brief returns the number of terms (e.g. samples) the function is the average of.
+        ///
+        /// NB: the functions that are not sample-decomposable consist of a single term.
+        ///
+        virtual tensor_size_t summands() const { return 1; }
+
+        ///
+        /// \brief evaluate the average of the given subset of terms at the given point (and its gradient if provided).
+        ///
+        /// NB: this is used by the stochastic solvers to process mini-batches of samples.
+        /// NB: the default implementation evaluates the whole function, as it consists of a single term.
+        ///
+        virtual scalar_t partial_vgrad(const vector_t& x, const indices_cmap_t& summands, vector_t* gx = nullptr) const;
+
+        ///
+        /// \brief evaluate the Hessian-vector product at the given point along the given direction.
+        ///
+        /// NB: this is used by the truncated Newton solvers that don't need to store the Hessian explicitly.
+        /// NB: the default implementation uses the central finite difference of the gradient along the direction.
+        ///
+        virtual void hvp(const vector_t& x, const vector_t& v, vector_t& hv) const;
+
+        ///
+        /// \brief returns the (estimated) number of bytes touched by a function evaluation,
+        ///     useful to estimate the memory bandwidth (e.g. when benchmarking the solvers).
+        ///
+        /// NB: the default implementation accounts only for reading the point and writing the gradient.
+        ///
+        virtual tensor_size_t bytes() const;
+
+        ///
+        /// \brief returns the (estimated) number of bytes touched by a Hessian-vector product (@see hvp).
+        ///
+        /// NB: the default implementation accounts for the two gradient evaluations of the finite difference.
+        ///
+        virtual tensor_size_t hvp_bytes() const;
+
+        ///
+        /// \brief evaluate the function's values at the given points (and their gradients if provided).
+        ///
+        /// NB: the points are stored as rows, so that the function values and the gradients are stored as:
+        ///     fx(i) = f(X.row(i)) and gx->row(i) = grad f(X.row(i)).
+        /// NB: this is used to evaluate many points at once (e.g. benchmarking) and it can be overriden
+        ///     to vectorize the computations across the points (e.g. for the separable functions).
+        /// NB: the default implementation evaluates each point in turn.
+        ///
+        virtual void vgrads(const matrix_t& X, vector_t& fx, matrix_t* gx = nullptr) const;
+
     private:
 
         // attributes
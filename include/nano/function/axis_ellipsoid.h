@@ -27,6 +27,18 @@ namespace nano
             return (x.array().square() * m_bias.array()).sum();
         }
 
+        void vgrads(const matrix_t& X, vector_t& fx, matrix_t* gx) const override
+        {
+            const auto bias = m_bias.array().transpose();
+
+            if (gx != nullptr)
+            {
+                *gx = (2 * X.array()).rowwise() * bias;
+            }
+
+            fx = (X.array().square().rowwise() * bias).rowwise().sum();
+        }
+
     private:
 
         // attributes
@@ -39,6 +39,26 @@ namespace nano
                 (2 * xsegm1.array().square() - xsegm0.array()).square()).sum();
         }
 
+        void vgrads(const matrix_t& X, vector_t& fx, matrix_t* gx) const override
+        {
+            const auto xsegm0 = X.leftCols(size() - 1).array();
+            const auto xsegm1 = X.rightCols(size() - 1).array();
+            const auto delta = 2 * xsegm1.square() - xsegm0;
+            const auto bias = m_bias.segment(1, size() - 1).array().transpose();
+
+            if (gx != nullptr)
+            {
+                const matrix_t weight = (2 * delta).rowwise() * bias;
+
+                gx->setZero(X.rows(), X.cols());
+                gx->col(0).array() = 2 * (X.col(0).array() - 1);
+                gx->rightCols(size() - 1).array() += weight.array() * 4 * xsegm1;
+                gx->leftCols(size() - 1).array() -= weight.array();
+            }
+
+            fx = (X.col(0).array() - 1).square() + (delta.square().rowwise() * bias).rowwise().sum();
+        }
+
     private:
 
         // attributes
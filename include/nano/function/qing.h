@@ -27,6 +27,18 @@ namespace nano
             return (x.array().square() - m_bias.array()).square().sum();
         }
 
+        void vgrads(const matrix_t& X, vector_t& fx, matrix_t* gx) const override
+        {
+            const auto delta = X.array().square().rowwise() - m_bias.array().transpose();
+
+            if (gx != nullptr)
+            {
+                *gx = 4 * delta * X.array();
+            }
+
+            fx = delta.square().rowwise().sum();
+        }
+
     private:
 
         // attributes
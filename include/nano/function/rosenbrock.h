@@ -40,5 +40,23 @@ namespace nano
 
             return fx;
         }
+
+        void vgrads(const matrix_t& X, vector_t& fx, matrix_t* gx) const override
+        {
+            const auto ct = scalar_t(100);
+
+            const auto xsegm0 = X.leftCols(size() - 1).array();
+            const auto xsegm1 = X.rightCols(size() - 1).array();
+            const auto delta = xsegm1 - xsegm0.square();
+
+            if (gx != nullptr)
+            {
+                gx->setZero(X.rows(), X.cols());
+                gx->leftCols(size() - 1).array() += 2 * (xsegm0 - 1) - ct * 4 * delta * xsegm0;
+                gx->rightCols(size() - 1).array() += ct * 2 * delta;
+            }
+
+            fx = (ct * delta.square() + (xsegm0 - 1).square()).rowwise().sum();
+        }
     };
 }
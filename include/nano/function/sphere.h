@@ -25,5 +25,15 @@ namespace nano
 
             return x.dot(x);
         }
+
+        void vgrads(const matrix_t& X, vector_t& fx, matrix_t* gx) const override
+        {
+            if (gx != nullptr)
+            {
+                *gx = 2 * X;
+            }
+
+            fx = X.rowwise().squaredNorm();
+        }
     };
 }
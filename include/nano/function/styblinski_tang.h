@@ -25,5 +25,15 @@ namespace nano
 
             return (x.array().square().square() - 16 * x.array().square() + 5 * x.array()).sum();
         }
+
+        void vgrads(const matrix_t& X, vector_t& fx, matrix_t* gx) const override
+        {
+            if (gx != nullptr)
+            {
+                *gx = 4 * X.array().cube() - 32 * X.array() + 5;
+            }
+
+            fx = (X.array().square().square() - 16 * X.array().square() + 5 * X.array()).rowwise().sum();
+        }
     };
 }
@@ -32,6 +32,20 @@ namespace nano
             return u + nano::square(v) + nano::quartic(v);
         }
 
+        void vgrads(const matrix_t& X, vector_t& fx, matrix_t* gx) const override
+        {
+            const vector_t u = X.rowwise().squaredNorm();
+            const vector_t v = X * m_bias;
+
+            if (gx != nullptr)
+            {
+                *gx = 2 * X;
+                gx->noalias() += (2 * v.array() + 4 * v.array().cube()).matrix() * m_bias.transpose();
+            }
+
+            fx = u.array() + v.array().square() + v.array().square().square();
+        }
+
     private:
 
         // attributes
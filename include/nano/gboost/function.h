@@ -51,6 +51,7 @@ namespace nano
     ///
     /// NB: the function_t interface is used only for testing/debugging
     ///     as it computes more than needed when training a Gradient Boosting model.
+    /// NB: the function must not be evaluated concurrently as the values and the gradients are buffered.
     ///
     class NANO_PUBLIC gboost_grads_function_t final : public gboost_function_t
     {
@@ -29,7 +29,10 @@ namespace nano
     ///     - training and evaluation is performed using all available threads.
     ///     - the bias computation and the scaling of the weak learners can be solved
     ///         using any of the available builtin line-search-based solvers (e.g. lBFGS, CGD, CG_DESCENT).
+    ///     - the scale factors of the weak learners are constrained to be non-negative
+    ///         (solved with lBFGS-B if the given solver doesn't support bound constraints).
     ///     - support for estimating the importance of the selected features.
+    ///     - support for computing the per-sample contributions of the selected features (SHAP values).
     ///
     /// see "The Elements of Statistical Learning", by Trevor Hastie, Robert Tibshirani, Jerome Friedman
     /// see "Greedy Function Approximation: A Gradient Boosting Machine", by Jerome Friedman
@@ -42,6 +45,8 @@ namespace nano
     {
     public:
 
+        using model_t::evaluate;
+
         ///
         /// \brief constructor
         ///
@@ -92,6 +97,30 @@ namespace nano
         ///
         tensor4d_t predict(const dataset_t&, const indices_t&) const override;
 
+        ///
+        /// \brief @see model_t
+        ///
+        void predict(const dataset_t&, const indices_cmap_t&, tensor4d_map_t outputs) const override;
+
+        ///
+        /// \brief returns the predictions of the given samples using the given dataset with the given feature shuffled
+        ///     (@see shuffle_dataset_t), by updating the baseline predictions of the original dataset (@see predict)
+        ///     with only the weak learners using the shuffled feature.
+        ///
+        /// NB: this is equivalent to (but cheaper than) predicting the shuffled dataset.
+        ///
+        tensor4d_t predict_shuffled(const dataset_t& dataset, const dataset_t& shuffled_dataset, tensor_size_t feature,
+            const indices_t&, const tensor4d_t& baseline_outputs) const;
+
+        ///
+        /// \brief returns the additive contributions of each feature to the predictions of the given samples
+        ///     (aka SHAP values) as a tensor of shape (#samples, #features + 1, #outputs).
+        ///
+        /// NB: the last slot stores the expected prediction (estimated over the given samples),
+        ///     such that the contributions of a sample sum up to its prediction.
+        ///
+        tensor3d_t contributions(const dataset_t&, const indices_t&) const;
+
         ///
         /// \brief returns the selected features, optionally with their associated importance.
         ///
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <algorithm>
+#include <type_traits>
 #include <nano/tensor.h>
+#include <nano/mlearn/feature.h>
 
 namespace nano { namespace gboost
 {
@@ -30,6 +32,24 @@ namespace nano { namespace gboost
         return (cache0 /= samples);
     }
 
+    ///
+    /// \brief call the given operator with the number of outputs as a compile-time constant
+    ///     for the most common cases (e.g. univariate regression, binary or few-class classification)
+    ///     and as Eigen::Dynamic otherwise.
+    ///
+    template <typename toperator>
+    void dispatch(const tensor_size_t tsize, const toperator& op)
+    {
+        switch (tsize)
+        {
+        case 1:     op(std::integral_constant<int, 1>{}); break;
+        case 2:     op(std::integral_constant<int, 2>{}); break;
+        case 3:     op(std::integral_constant<int, 3>{}); break;
+        case 4:     op(std::integral_constant<int, 4>{}); break;
+        default:    op(std::integral_constant<int, Eigen::Dynamic>{}); break;
+        }
+    }
+
     ///
     /// \brief accumulates residuals & feature values of different moment orders
     ///     useful for fitting simple weak learners.
@@ -105,10 +125,133 @@ namespace nano { namespace gboost
             rx(fv) -= vgrad * value;
         }
 
+        ///
+        /// \brief accumulate the gradient of a sample given as a pointer to its `tdim`-sized array
+        ///     using a kernel specialized for the compile-time number of outputs (see dispatch).
+        ///
+        template <int tsize>
+        void update(const scalar_t* vgrad, tensor_size_t fv = 0)
+        {
+            const auto g = cmap<tsize>(vgrad);
+
+            m_x0(fv) += 1;
+            map<tsize>(m_r1, fv) -= g;
+            map<tsize>(m_r2, fv) += g * g;
+        }
+
+        template <int tsize>
+        void update(scalar_t value, const scalar_t* vgrad, tensor_size_t fv = 0)
+        {
+            const auto g = cmap<tsize>(vgrad);
+
+            m_x0(fv) += 1;
+            m_x1(fv) += value;
+            m_x2(fv) += value * value;
+            map<tsize>(m_r1, fv) -= g;
+            map<tsize>(m_rx, fv) -= g * value;
+            map<tsize>(m_r2, fv) += g * g;
+        }
+
+        ///
+        /// \brief accumulate the gradients of the given samples with non-missing feature values.
+        ///
+        /// NB: the samples are processed in blocks gathered contiguously (structure-of-arrays),
+        ///     so that the reductions over samples are vectorized.
+        ///
+        void update(const tensor1d_t& fvalues, const indices_t& samples, const tensor4d_t& gradients)
+        {
+            update<false>(fvalues, samples, gradients, [] (scalar_t value) { return value; });
+        }
+
+        ///
+        /// \brief accumulate the gradients and the (transformed) feature values
+        ///     of the given samples with non-missing feature values.
+        ///
+        template <typename tvalue>
+        void update(const tensor1d_t& fvalues, const indices_t& samples, const tensor4d_t& gradients,
+            const tvalue& value)
+        {
+            update<true>(fvalues, samples, gradients, value);
+        }
+
     private:
 
+        auto outputs() const
+        {
+            return m_r1.size<1>() * m_r1.size<2>() * m_r1.size<3>();
+        }
+
+        template <int tsize>
+        auto cmap(const scalar_t* data) const
+        {
+            return Eigen::Map<const Eigen::Array<scalar_t, tsize, 1>>(data, outputs());
+        }
+
+        template <int tsize>
+        auto map(tensor4d_t& tensor, tensor_size_t fv) const
+        {
+            return Eigen::Map<Eigen::Array<scalar_t, tsize, 1>>(tensor.vector(fv).data(), outputs());
+        }
+
+        template <bool tmoments, typename tvalue>
+        void update(const tensor1d_t& fvalues, const indices_t& samples, const tensor4d_t& gradients,
+            const tvalue& value)
+        {
+            assert(fvalues.size() == samples.size());
+            assert(gradients.size<0>() > samples.max());
+
+            static constexpr tensor_size_t block_size = 64;
+
+            m_block_g.resize(block_size, outputs());
+            m_block_x.resize(block_size);
+
+            tensor_size_t count = 0;
+            const auto flush = [&] ()
+            {
+                const auto g = m_block_g.topRows(count);
+                const auto x = m_block_x.head(count);
+
+                m_x0(0) += static_cast<scalar_t>(count);
+                m_r1.vector(0) -= g.colwise().sum().transpose();
+                m_r2.vector(0) += g.array().square().colwise().sum().matrix().transpose();
+                if constexpr (tmoments)
+                {
+                    m_x1(0) += x.sum();
+                    m_x2(0) += x.squaredNorm();
+                    m_rx.vector(0) -= g.transpose() * x;
+                }
+                count = 0;
+            };
+
+            for (tensor_size_t i = 0; i < samples.size(); ++ i)
+            {
+                const auto fvalue = fvalues(i);
+                if (feature_t::missing(fvalue))
+                {
+                    continue;
+                }
+
+                m_block_g.row(count) = gradients.vector(samples(i)).transpose();
+                if constexpr (tmoments)
+                {
+                    m_block_x(count) = value(fvalue);
+                }
+                if (++ count == block_size)
+                {
+                    flush();
+                }
+            }
+
+            if (count > 0)
+            {
+                flush();
+            }
+        }
+
         // attributes
         tensor1d_t  m_x0, m_x1, m_x2;       ///<
         tensor4d_t  m_r1, m_rx, m_r2;       ///<
+        matrix_t    m_block_g;              ///< buffer: block of gathered gradients (samples, #outputs)
+        vector_t    m_block_x;              ///< buffer: block of gathered feature values (samples)
     };
 }}
@@ -65,6 +65,18 @@ namespace nano
         tensor4d_t predict(const dataset_t&, const indices_cmap_t&) const;
         virtual void predict(const dataset_t&, const indices_cmap_t&, tensor4d_map_t) const = 0;
 
+        ///
+        /// \brief compute the additive contributions of the selected features to the predictions of the given samples
+        ///     (aka SHAP values) and add them to the given buffer of shape (#samples, #features + 1, #outputs).
+        ///
+        /// NB: the expected prediction (estimated over the training samples) is added to the last slot,
+        ///     such that the contributions of a sample sum up to its prediction.
+        /// NB: the contributions of a sample do not depend on the other given samples.
+        /// NB: the default implementation handles the weak learners using a single feature
+        ///     and requires the expected prediction to be set (@see expected).
+        ///
+        virtual void contributions(const dataset_t&, const indices_t&, tensor3d_map_t) const;
+
         ///
         /// \brief select the feature or the features and estimate their associated parameters
         ///     that matches the best the given residuals/gradients in terms of the L2-norm
@@ -100,6 +112,14 @@ namespace nano
         ///
         void batch(int batch);
 
+        ///
+        /// \brief set the expected prediction (of shape #outputs) over the training samples,
+        ///     used as the baseline of the feature contributions.
+        ///
+        /// NB: this needs to be set again if the weak learner is scaled afterwards.
+        ///
+        void expected(tensor1d_t expected);
+
         ///
         /// \brief score that indicates fitting failed (e.g. unsupported feature types).
         ///
@@ -109,6 +129,7 @@ namespace nano
         /// \brief access functions
         ///
         auto batch() const { return m_batch.get(); }
+        const auto& expected() const { return m_expected; }
 
     protected:
 
@@ -119,5 +140,6 @@ namespace nano
 
         // attributes
         iparam1_t   m_batch{"wlearner::batch", 1, LE, 32, LE, 1024};        ///< batch size
+        tensor1d_t  m_expected;                                             ///< expected prediction (#outputs)
     };
 }
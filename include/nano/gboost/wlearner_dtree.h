@@ -116,6 +116,15 @@ namespace nano
         ///
         void predict(const dataset_t&, const indices_cmap_t&, tensor4d_map_t) const override;
 
+        ///
+        /// \brief @see wlearner_t
+        ///
+        /// NB: the contributions are computed exactly in polynomial time using the path-dependent TreeSHAP algorithm,
+        ///     see "Consistent Individualized Feature Attribution for Tree Ensembles", by S. Lundberg, G. Erion, S.-I. Lee.
+        /// NB: the expected prediction and the node covers are estimated from the training samples.
+        ///
+        void contributions(const dataset_t&, const indices_t&, tensor3d_map_t) const override;
+
         ///
         /// \brief @see wlearner_t
         ///
@@ -158,5 +167,6 @@ namespace nano
         dtree_nodes_t   m_nodes;                ///< nodes in the decision tree
         tensor4d_t      m_tables;               ///< (#feature values, #outputs) - predictions at the leaves
         indices_t       m_features;             ///< unique set of the selected features
+        tensor2d_t      m_covers;               ///< (2, #nodes) - number of training samples reaching each node and split
     };
 }
@@ -81,8 +81,13 @@ namespace nano
         }
 
         // attributes
+        tensor4d_t  m_inputs;       ///< buffer: gathered inputs (double precision)
+        tensor_mem_t<float, 4> m_inputs32;///< buffer: gathered inputs (single precision)
+        tensor4d_t  m_targets;      ///< buffer: gathered targets
+        indices_t   m_indices;      ///< buffer: gathered sample indices (sparse inputs)
         tensor4d_t  m_outputs;      ///< buffer: predictions
         tensor4d_t  m_vgrads;       ///< buffer: gradients wrt predictions
+        tensor4d_t  m_doutputs;     ///< buffer: directional derivatives of the predictions (Hessian-vector products)
         tensor1d_t  m_values;       ///< buffer: loss values
         scalar_t    m_vm1{0};       ///< first order momentum of the loss values
         scalar_t    m_vm2{0};       ///< second order momentum of the loss values
@@ -7,10 +7,24 @@
 
 namespace nano
 {
+    class sparse_dataset_t;
+
     ///
     /// \brief the ERM criterion used for optimizing the parameters of a linear model,
     ///     using a given loss function.
     ///
+    /// NB: the (normalized) inputs and the targets of the given samples are cached at construction
+    ///     (and re-normalized only when the normalization method changes),
+    ///     as they don't change during optimization.
+    ///
+    /// NB: the cached inputs can be stored in single precision (@see nano::precision)
+    ///     to speed-up the predictions, while the loss values and the gradients
+    ///     are still cumulated in double precision (the inputs are converted back per batch).
+    ///
+    /// NB: the sparse inputs (@see sparse_dataset_t) are not cached, but processed directly in the CSR format
+    ///     using sparse x dense products and scatter-add gradients.
+    ///     They are not normalized (to preserve sparsity) and the computations are performed in double precision.
+    ///
     /// NB: the ERM loss can be optionally regularized by penalizing:
     ///     - (1) the L1-norm of the weights matrix - like in LASSO
     ///     - (2) the L2-norm of the weights matrix - like in RIDGE (regression)
@@ -24,7 +38,10 @@ namespace nano
         ///
         /// \brief constructor
         ///
-        linear_function_t(const loss_t&, const dataset_t&, const indices_t&);
+        /// NB: the inputs are cached using the given normalization and precision in a single pass over the samples.
+        ///
+        linear_function_t(const loss_t&, const dataset_t&, const indices_t&,
+            ::nano::normalization = ::nano::normalization::none, ::nano::precision = ::nano::precision::f64);
 
         ///
         /// \brief enable coying
@@ -82,6 +99,56 @@ namespace nano
         ///
         scalar_t vgrad(const vector_t& x, vector_t* gx = nullptr) const override;
 
+        ///
+        /// \brief @see function_t
+        ///
+        /// NB: the regularization terms are added as they are to the average loss of the given samples,
+        ///     while the variance of the loss values is estimated only from the given samples.
+        ///
+        tensor_size_t summands() const override { return m_samples.size(); }
+        scalar_t partial_vgrad(const vector_t& x, const indices_cmap_t& summands, vector_t* gx = nullptr) const override;
+
+        ///
+        /// \brief @see function_t
+        ///
+        /// NB: the Hessian-vector product is computed in a single pass over the samples as:
+        ///     H * v = 1/N * sum_i [x_i, 1]^T * D_i * (V^T * x_i + v_b) + the regularization term,
+        ///     where D_i is the Hessian of the loss wrt the predictions of the i-th sample.
+        /// NB: the product D_i * u_i is computed by the loss function (@see loss_t::hvp),
+        ///     either exactly or with the central finite difference of the loss gradient along u_i.
+        /// NB: the variance regularization term is not sample-decomposable and
+        ///     then the default implementation is used (@see function_t::hvp).
+        ///
+        void hvp(const vector_t& x, const vector_t& v, vector_t& hv) const override;
+
+        ///
+        /// \brief @see function_t
+        ///
+        /// NB: the cached (or the sparse) inputs and the targets of all samples are read once per evaluation.
+        ///
+        tensor_size_t bytes() const override { return m_bytes; }
+
+        ///
+        /// \brief @see function_t
+        ///
+        /// NB: the Hessian-vector product reads the samples once, unless the default implementation is used.
+        ///
+        tensor_size_t hvp_bytes() const override;
+
+        ///
+        /// \brief returns true if the optimum can be computed in closed form (@see solve),
+        ///     i.e. for the squared loss regularized at most with the L2-norm of the weights matrix.
+        ///
+        bool closed_form() const;
+
+        ///
+        /// \brief compute the optimum in closed form by solving the (regularized) normal equations
+        ///     with a Cholesky (LDLT) decomposition.
+        ///
+        /// NB: the sufficient statistics (X^T * X and X^T * Y) are cumulated in a single pass over the samples.
+        ///
+        vector_t solve() const;
+
         ///
         /// \brief change parameters
         ///
@@ -89,7 +156,8 @@ namespace nano
         void l2reg(const scalar_t l2reg) { m_l2reg.set(l2reg); }
         void vAreg(const scalar_t vAreg) { m_vAreg.set(vAreg); }
         void batch(const tensor_size_t batch) { m_batch.set(batch); }
-        void normalization(const normalization n) { m_normalization = n; }
+        void normalization(::nano::normalization);
+        void precision(::nano::precision);
 
         ///
         /// \brief access functions
@@ -105,13 +173,18 @@ namespace nano
         const auto& dataset() const { return m_dataset; }
         const auto& samples() const { return m_samples; }
         auto normalization() const { return m_normalization; }
+        auto precision() const { return m_precision; }
 
     private:
 
+        void update_inputs();
+        scalar_t evaluate(const vector_t& x, const indices_cmap_t* summands, vector_t* gx) const;
+
         // attributes
         const loss_t&       m_loss;         ///<
         const dataset_t&    m_dataset;      ///<
         const indices_t&    m_samples;      ///<
+        const sparse_dataset_t* m_sparse{nullptr};///< the dataset if storing sparse inputs
         tensor_size_t       m_isize{0};     ///< #inputs (e.g. size of the flatten input feature tensor)
         tensor_size_t       m_tsize{0};     ///< #targets (e.g. size of the flatten target tensor, number of classes)
         sparam1_t           m_l1reg{"linear::L1", 0, LE, 0, LE, 1e+8};  ///< regularization factor - see (1), (3)
@@ -119,6 +192,11 @@ namespace nano
         sparam1_t           m_vAreg{"linear::VA", 0, LE, 0, LE, 1e+8};  ///< regularization factor - see (4)
         iparam1_t           m_batch{"linear::batch", 1, LE, 32, LE, 4092};///< batch size in number of samples
         ::nano::normalization m_normalization{::nano::normalization::none};///<
+        ::nano::precision   m_precision{::nano::precision::f64};///<
         elemwise_stats_t    m_istats;       ///< element-wise statistics to be used for normalization
+        tensor4d_t          m_inputs;       ///< cached (normalized) inputs of the given samples (double precision)
+        tensor_mem_t<float, 4> m_inputs32;  ///< cached (normalized) inputs of the given samples (single precision)
+        tensor4d_t          m_targets;      ///< cached targets of the given samples
+        tensor_size_t       m_bytes{0};     ///< cached number of bytes touched by a function evaluation
     };
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <nano/model.h>
+#include <nano/linear/function.h>
 
 namespace nano
 {
@@ -24,6 +25,13 @@ namespace nano
     ///     - variance (of the loss values across samples) by tuning ::vAreg() accordingly.
     ///
     /// NB: the inputs should be normalized during training to speed-up convergence (@see nano::normalization).
+    /// NB: the training can be performed in single precision to speed-up the evaluations (@see nano::precision).
+    /// NB: the optimum is computed in closed form (by solving the normal equations)
+    ///     for the squared loss if regularized at most with the L2-norm of the weights (aka ridge regression).
+    /// NB: the L1-regularized problems are solved using the accelerated proximal gradient method
+    ///     (@see linear::fista) to produce exactly sparse weights,
+    ///     using the accuracy and the maximum number of iterations of the given solver.
+    /// NB: the given solver is used only for the other configurations.
     ///
     /// see "Regression Shrinkage and Selection via the lasso", by R. Tibshirani
     /// see "Empirical Bernstein Boosting", by Pannagadatta K. Shivaswamy & Tony Jebara
@@ -58,11 +66,29 @@ namespace nano
         ///
         scalar_t fit(const loss_t&, const dataset_t&, const indices_t&, const solver_t&) override;
 
+        ///
+        /// \brief fit the model for each of the given values of the given regularization factor
+        ///     (e.g. "linear::l1reg", "linear::l2reg" or "linear::vAreg") and returns the fitted models
+        ///     (aka the regularization path) in the descending order of the regularization factor.
+        ///
+        /// NB: each optimization is warm-started from the solution of the previous (more regularized) problem,
+        ///     while the (normalized) inputs are cached only once for the whole path.
+        /// NB: the model is set to the last (least regularized) fitted model.
+        ///
+        std::vector<linear_model_t> fit(
+            const loss_t&, const dataset_t&, const indices_t&, const solver_t&,
+            const string_t& param, std::vector<scalar_t> values);
+
         ///
         /// \brief @see model_t
         ///
         tensor4d_t predict(const dataset_t&, const indices_t&) const override;
 
+        ///
+        /// \brief @see model_t
+        ///
+        void predict(const dataset_t&, const indices_cmap_t&, tensor4d_map_t outputs) const override;
+
         ///
         /// \brief configure the model.
         ///
@@ -71,18 +97,23 @@ namespace nano
         void l2reg(scalar_t l2reg) { set("linear::l2reg", l2reg); }
         void vAreg(scalar_t vAreg) { set("linear::vAreg", vAreg); }
         void normalization(::nano::normalization normalization) { set("linear::normalization", normalization); }
+        void precision(::nano::precision precision) { set("linear::precision", precision); }
 
         auto batch() const { return ivalue("linear::batch"); }
         auto l1reg() const { return svalue("linear::l1reg"); }
         auto l2reg() const { return svalue("linear::l2reg"); }
         auto vAreg() const { return svalue("linear::vAreg"); }
         auto normalization() const { return evalue<::nano::normalization>("linear::normalization"); }
+        auto precision() const { return evalue<::nano::precision>("linear::precision"); }
 
         const auto& bias() const { return m_bias; }
         const auto& weights() const { return m_weights; }
 
     private:
 
+        linear_function_t make_function(const loss_t&, const dataset_t&, const indices_t&) const;
+        solver_state_t minimize(linear_function_t&, const solver_t&, const vector_t& x0);
+
         // attributes
         tensor1d_t      m_bias;             ///< bias vector (#outputs)
         tensor2d_t      m_weights;          ///< weight matrix (#inputs, #outputs)
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <nano/solver/state.h>
+#include <nano/linear/function.h>
+
+namespace nano { namespace linear
+{
+    ///
+    /// \brief minimize the L1-regularized ERM criterion of a linear model using
+    ///     the accelerated proximal gradient method with backtracking and adaptive restarts (FISTA).
+    ///
+    /// NB: the L1-norm of the weights is handled by its proximal operator (soft-thresholding),
+    ///     thus the resulting weights are exactly sparse
+    ///     (unlike the smooth solvers using the sign() subgradient).
+    ///
+    /// NB: the returned state stores the minimum-norm subgradient,
+    ///     such that its convergence criterion measures the optimality of the solution.
+    ///
+    /// see "A Fast Iterative Shrinkage-Thresholding Algorithm for Linear Inverse Problems", by A. Beck & M. Teboulle
+    /// see "Adaptive Restart for Accelerated Gradient Schemes", by B. O'Donoghue & E. Candes
+    ///
+    NANO_PUBLIC solver_state_t fista(
+        linear_function_t&, const vector_t& x0, scalar_t epsilon, int64_t max_iterations);
+}}
@@ -24,6 +24,34 @@ namespace nano { namespace linear
         outputs.reshape(samples, tsize).matrix().rowwise() += bias.vector().transpose();
     }
 
+    ///
+    /// \brief compute the predictions of the linear model with the given weights and bias
+    ///     for the given samples with sparse inputs stored in CSR format (@see sparse_dataset_t).
+    ///
+    inline void predict(
+        const indices_cmap_t& offsets, const indices_cmap_t& findices, const tensor1d_cmap_t& fvalues,
+        const indices_cmap_t& samples, const tensor2d_cmap_t& weights, const tensor1d_cmap_t& bias,
+        tensor4d_map_t&& outputs)
+    {
+        const auto tsize = weights.cols();
+        const auto wmatrix = weights.matrix();
+
+        assert(tsize == bias.size());
+        assert(samples.size() == outputs.size<0>());
+        assert(samples.size() * tsize == outputs.size());
+
+        auto omatrix = outputs.reshape(samples.size(), tsize).matrix();
+        omatrix.rowwise() = bias.vector().transpose();
+
+        for (tensor_size_t i = 0; i < samples.size(); ++ i)
+        {
+            for (auto k = offsets(samples(i)), end = offsets(samples(i) + 1); k < end; ++ k)
+            {
+                omatrix.row(i) += fvalues(k) * wmatrix.row(findices(k));
+            }
+        }
+    }
+
     ///
     /// \brief compute the predictions of the linear model with the given weights and bias.
     ///
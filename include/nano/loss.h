@@ -59,6 +59,29 @@ namespace nano
         virtual void value(const tensor4d_cmap_t& targets, const tensor4d_cmap_t& outputs, tensor1d_map_t) const = 0;
         virtual void vgrad(const tensor4d_cmap_t& targets, const tensor4d_cmap_t& outputs, tensor4d_map_t) const = 0;
 
+        ///
+        /// \brief compute both the loss value and the loss' gradient wrt the output for the given samples.
+        ///
+        /// NB: the default implementation calls value() and vgrad(),
+        ///     but it should be overridden to share the intermediate computations (e.g. exponentials).
+        ///
+        virtual void value_vgrad(const tensor4d_cmap_t& targets, const tensor4d_cmap_t& outputs,
+            tensor1d_map_t values, tensor4d_map_t vgrads) const
+        {
+            value(targets, outputs, values);
+            vgrad(targets, outputs, vgrads);
+        }
+
+        ///
+        /// \brief compute the product of the loss' Hessian wrt the output with the given directions for the given samples:
+        ///     hu_i = d^2 loss(target_i, output_i) / d output_i^2 * u_i.
+        ///
+        /// NB: the default implementation uses central finite differences of the loss' gradient wrt the output,
+        ///     but it should be overridden to compute the exact products (e.g. for smooth losses).
+        ///
+        virtual void hvp(const tensor4d_cmap_t& targets, const tensor4d_cmap_t& outputs,
+            const tensor4d_cmap_t& u, tensor4d_map_t hu) const;
+
         ///
         /// \brief overloads to simplify usage.
         ///
@@ -81,5 +104,20 @@ namespace nano
             vgrads.resize(targets.dims());
             vgrad(targets, outputs, vgrads.tensor());
         }
+
+        void value_vgrad(const tensor4d_cmap_t& targets, const tensor4d_cmap_t& outputs,
+            tensor1d_t& values, tensor4d_t& vgrads) const
+        {
+            values.resize(targets.size<0>());
+            vgrads.resize(targets.dims());
+            value_vgrad(targets, outputs, values.tensor(), vgrads.tensor());
+        }
+
+        void hvp(const tensor4d_cmap_t& targets, const tensor4d_cmap_t& outputs,
+            const tensor4d_cmap_t& u, tensor4d_t& hu) const
+        {
+            hu.resize(targets.dims());
+            hvp(targets, outputs, u, hu.tensor());
+        }
     };
 }
@@ -1,11 +1,32 @@
 #pragma once
 
 #include <cassert>
+#include <type_traits>
 #include <nano/loss.h>
 #include <nano/mlearn/class.h>
 
 namespace nano
 {
+    namespace detail
+    {
+        using loss_array_t = Eigen::Array<scalar_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+        ///
+        /// \brief checks if the given loss implements the exact Hessian-vector products wrt the output.
+        ///
+        template <typename top, typename = void>
+        struct has_hvp : std::false_type
+        {
+        };
+
+        template <typename top>
+        struct has_hvp<top, std::void_t<decltype(top::hvp(
+            std::declval<const loss_array_t&>(), std::declval<const loss_array_t&>(),
+            std::declval<const loss_array_t&>(), std::declval<loss_array_t&>()))>> : std::true_type
+        {
+        };
+    }
+
     ///
     /// \brief un-structured loss function: the 3D structure of a sample is flatten
     ///     and all dimensions are considered the same in computing the loss.
@@ -22,6 +43,8 @@ namespace nano
     /// (2): "On the design of loss functions for classification: theory, robustness to outliers, and SavageBoost",
     ///      2008, by H. Masnadi-Shirazi, N. Vasconcelos
     ///
+    /// NB: the loss values and gradients are computed with branch-free Eigen array expressions.
+    ///
     template <typename top>
     class array_loss_t final : public loss_t
     {
@@ -68,6 +91,54 @@ namespace nano
                 top::vgrad(targets.array(i), outputs.array(i), vgrads.array(i));
             }
         }
+
+        ///
+        /// \brief @see loss_t
+        ///
+        /// NB: the loss values and gradients are computed at once for all samples as (samples, tsize) arrays,
+        ///     so that the element-wise operations (e.g. exponentials) are evaluated once for both.
+        ///
+        void value_vgrad(const tensor4d_cmap_t& targets, const tensor4d_cmap_t& outputs,
+            tensor1d_map_t values, tensor4d_map_t vgrads) const override
+        {
+            assert(targets.dims() == vgrads.dims());
+            assert(targets.dims() == outputs.dims());
+            assert(values.size() == targets.size<0>());
+
+            const auto samples = targets.size<0>();
+            top::value_vgrad(
+                targets.reshape(samples, -1).matrix().array(),
+                outputs.reshape(samples, -1).matrix().array(),
+                values.array(),
+                vgrads.reshape(samples, -1).matrix().array());
+        }
+
+        ///
+        /// \brief @see loss_t
+        ///
+        /// NB: the finite difference approximation is used if the exact products are not implemented.
+        ///
+        void hvp(const tensor4d_cmap_t& targets, const tensor4d_cmap_t& outputs,
+            const tensor4d_cmap_t& u, tensor4d_map_t hu) const override
+        {
+            if constexpr (detail::has_hvp<top>::value)
+            {
+                assert(targets.dims() == hu.dims());
+                assert(targets.dims() == outputs.dims());
+                assert(targets.dims() == u.dims());
+
+                const auto samples = targets.size<0>();
+                top::hvp(
+                    targets.reshape(samples, -1).matrix().array(),
+                    outputs.reshape(samples, -1).matrix().array(),
+                    u.reshape(samples, -1).matrix().array(),
+                    hu.reshape(samples, -1).matrix().array());
+            }
+            else
+            {
+                loss_t::hvp(targets, outputs, u, hu);
+            }
+        }
     };
 
     namespace detail
@@ -132,40 +203,41 @@ namespace nano
             template <typename tarray>
             static auto value(const tarray& target, const tarray& output)
             {
-                tensor_size_t imax = 0;
-                const auto omax = output.maxCoeff(&imax);
-
-                scalar_t value = 0, posum = 0;
-                for (tensor_size_t i = 0, size = target.size(); i < size; ++ i)
-                {
-                    value += std::exp(output(i) - omax);
-                    if (is_pos_target(target(i)))
-                    {
-                        posum += output(i);
-                    }
-                }
-                return std::log(value) - posum + omax;
+                const auto omax = output.maxCoeff();
+                return std::log((output - omax).exp().sum()) + omax - (target > 0).select(output, scalar_t(0)).sum();
             }
 
             template <typename tarray, typename tgarray>
             static void vgrad(const tarray& target, const tarray& output, tgarray&& vgrad)
             {
-                tensor_size_t imax = 0;
-                const auto omax = output.maxCoeff(&imax);
+                const auto omax = output.maxCoeff();
 
-                scalar_t value = 0;
-                for (tensor_size_t i = 0, size = target.size(); i < size; ++ i)
-                {
-                    value += (vgrad(i) = std::exp(output(i) - omax));
-                }
-                for (tensor_size_t i = 0, size = target.size(); i < size; ++ i)
-                {
-                    vgrad(i) /= value;
-                    if (is_pos_target(target(i)))
-                    {
-                        vgrad(i) -= 1.0;
-                    }
-                }
+                vgrad = (output - omax).exp();
+                vgrad /= vgrad.sum();
+                vgrad -= (target > 0).template cast<scalar_t>();
+            }
+
+            template <typename tarray, typename tvarray, typename tgarray>
+            static void value_vgrad(const tarray& target, const tarray& output, tvarray&& values, tgarray&& vgrad)
+            {
+                const auto omax = output.rowwise().maxCoeff().eval();
+
+                vgrad = (output.colwise() - omax).exp();
+                const auto osum = vgrad.rowwise().sum().eval();
+
+                values = osum.log() + omax - (target > 0).select(output, scalar_t(0)).rowwise().sum();
+                vgrad = vgrad.colwise() / osum - (target > 0).template cast<scalar_t>();
+            }
+
+            template <typename tarray, typename tharray>
+            static void hvp(const tarray&, const tarray& output, const tarray& u, tharray&& hu)
+            {
+                // NB: the Hessian is diag(p) - p * p^T, where p = softmax(output)
+                const auto omax = output.rowwise().maxCoeff().eval();
+
+                hu = (output.colwise() - omax).exp();
+                hu = hu.colwise() / hu.rowwise().sum().eval();
+                hu = hu * (u.colwise() - (hu * u).rowwise().sum().eval());
             }
         };
 
@@ -186,6 +258,20 @@ namespace nano
             {
                 vgrad = -target * (-target * output).exp();
             }
+
+            template <typename tarray, typename tvarray, typename tgarray>
+            static void value_vgrad(const tarray& target, const tarray& output, tvarray&& values, tgarray&& vgrad)
+            {
+                vgrad = (-target * output).exp();
+                values = vgrad.rowwise().sum();
+                vgrad *= -target;
+            }
+
+            template <typename tarray, typename tharray>
+            static void hvp(const tarray& target, const tarray& output, const tarray& u, tharray&& hu)
+            {
+                hu = target.square() * (-target * output).exp() * u;
+            }
         };
 
         ///
@@ -197,24 +283,33 @@ namespace nano
             template <typename tarray>
             static auto value(const tarray& target, const tarray& output)
             {
-                scalar_t value = 0.0;
-                for (tensor_size_t i = 0, size = target.size(); i < size; ++ i)
-                {
-                    const auto x = -target(i) * output(i);
-                    value += (x < 1.0) ? std::log1p(std::exp(x)) : (x + std::log1p(std::exp(-x)));
-                }
-                return value;
+                // NB: log(1 + exp(x)) = max(x, 0) + log(1 + exp(-|x|)), where x = -target * output
+                return ((-target * output).max(scalar_t(0)) + (-(target * output).abs()).exp().log1p()).sum();
             }
 
             template <typename tarray, typename tgarray>
             static void vgrad(const tarray& target, const tarray& output, tgarray&& vgrad)
             {
-                for (tensor_size_t i = 0, size = target.size(); i < size; ++ i)
-                {
-                    const auto x = -target(i) * output(i);
-                    const auto g = (x < 1.0) ? (std::exp(x) / (1.0 + std::exp(x))) : (1.0 / (1.0 + std::exp(-x)));
-                    vgrad(i) = -target(i) * g;
-                }
+                // NB: sigmoid(x) = 1 / (1 + exp(-x)) = exp(x) / (1 + exp(x)), where x = -target * output
+                vgrad = (-(target * output).abs()).exp();
+                vgrad = -target * (target * output <= 0).select(1 / (1 + vgrad), vgrad / (1 + vgrad));
+            }
+
+            template <typename tarray, typename tvarray, typename tgarray>
+            static void value_vgrad(const tarray& target, const tarray& output, tvarray&& values, tgarray&& vgrad)
+            {
+                // NB: exp(-|x|) is shared by the numerically stable value and gradient, where x = -target * output
+                vgrad = (-(target * output).abs()).exp();
+                values = ((-target * output).max(scalar_t(0)) + vgrad.log1p()).rowwise().sum();
+                vgrad = -target * (target * output <= 0).select(1 / (1 + vgrad), vgrad / (1 + vgrad));
+            }
+
+            template <typename tarray, typename tharray>
+            static void hvp(const tarray& target, const tarray& output, const tarray& u, tharray&& hu)
+            {
+                // NB: sigmoid(x) * (1 - sigmoid(x)) = exp(-|x|) / (1 + exp(-|x|))^2, where x = -target * output
+                hu = (-(target * output).abs()).exp();
+                hu = target.square() * hu / (1 + hu).square() * u;
             }
         };
 
@@ -235,6 +330,13 @@ namespace nano
             {
                 vgrad = -target * ((1 - target * output).sign() + 1) * 0.5;
             }
+
+            template <typename tarray, typename tvarray, typename tgarray>
+            static void value_vgrad(const tarray& target, const tarray& output, tvarray&& values, tgarray&& vgrad)
+            {
+                values = (1 - target * output).max(0).rowwise().sum();
+                vgrad = -target * ((1 - target * output).sign() + 1) * 0.5;
+            }
         };
 
         ///
@@ -252,7 +354,16 @@ namespace nano
             template <typename tarray, typename tgarray>
             static void vgrad(const tarray& target, const tarray& output, tgarray&& vgrad)
             {
-                vgrad = -2 * target / ((1 + (target * output).exp()).square() * (1 + (-target * output).exp()));
+                vgrad = (target * output).exp();
+                vgrad = -2 * target / ((1 + vgrad).square() * (1 + 1 / vgrad));
+            }
+
+            template <typename tarray, typename tvarray, typename tgarray>
+            static void value_vgrad(const tarray& target, const tarray& output, tvarray&& values, tgarray&& vgrad)
+            {
+                vgrad = (target * output).exp();
+                values = (1 / (1 + vgrad).square()).rowwise().sum();
+                vgrad = -2 * target / ((1 + vgrad).square() * (1 + 1 / vgrad));
             }
         };
 
@@ -273,6 +384,14 @@ namespace nano
             {
                 vgrad = 4 * target * (2 * (target * output).atan() - 1) / (1 + (target * output).square());
             }
+
+            template <typename tarray, typename tvarray, typename tgarray>
+            static void value_vgrad(const tarray& target, const tarray& output, tvarray&& values, tgarray&& vgrad)
+            {
+                vgrad = 2 * (target * output).atan() - 1;
+                values = vgrad.square().rowwise().sum();
+                vgrad = 4 * target * vgrad / (1 + (target * output).square());
+            }
         };
 
         ///
@@ -292,6 +411,14 @@ namespace nano
             {
                 vgrad = (output - target).sign();
             }
+
+            template <typename tarray, typename tvarray, typename tgarray>
+            static void value_vgrad(const tarray& target, const tarray& output, tvarray&& values, tgarray&& vgrad)
+            {
+                vgrad = output - target;
+                values = vgrad.abs().rowwise().sum();
+                vgrad = vgrad.sign();
+            }
         };
 
         ///
@@ -311,6 +438,19 @@ namespace nano
             {
                 vgrad = output - target;
             }
+
+            template <typename tarray, typename tvarray, typename tgarray>
+            static void value_vgrad(const tarray& target, const tarray& output, tvarray&& values, tgarray&& vgrad)
+            {
+                vgrad = output - target;
+                values = scalar_t(0.5) * vgrad.square().rowwise().sum();
+            }
+
+            template <typename tarray, typename tharray>
+            static void hvp(const tarray&, const tarray&, const tarray& u, tharray&& hu)
+            {
+                hu = u;
+            }
         };
 
         ///
@@ -330,6 +470,14 @@ namespace nano
             {
                 vgrad = (output - target) / (1 + (output - target).square());
             }
+
+            template <typename tarray, typename tvarray, typename tgarray>
+            static void value_vgrad(const tarray& target, const tarray& output, tvarray&& values, tgarray&& vgrad)
+            {
+                vgrad = output - target;
+                values = scalar_t(0.5) * (vgrad.square() + 1).log().rowwise().sum();
+                vgrad = vgrad / (1 + vgrad.square());
+            }
         };
     }
 
@@ -64,6 +64,27 @@ namespace nano
         };
     }
 
+    ///
+    /// \brief floating point precision used to store the (normalized) inputs and to compute the linear transformations.
+    ///
+    /// NB: the reductions (e.g. the gradients) are always cumulated in double precision.
+    ///
+    enum class precision
+    {
+        f64 = 0,        ///< double precision
+        f32,            ///< single precision: half the memory bandwidth and twice the SIMD width, but less accurate
+    };
+
+    template <>
+    inline enum_map_t<precision> enum_string<precision>()
+    {
+        return
+        {
+            { precision::f64,       "f64" },
+            { precision::f32,       "f32" }
+        };
+    }
+
     ///
     /// \brief method to scale weak learners.
     ///
@@ -26,6 +26,12 @@ namespace nano
         ///
         scalar_t vgrad(const vector_t& x, vector_t* gx = nullptr) const override;
 
+        ///
+        /// \brief @see function_t
+        ///
+        tensor_size_t summands() const override { return m_targets.size<0>(); }
+        scalar_t partial_vgrad(const vector_t& x, const indices_cmap_t& summands, vector_t* gx = nullptr) const override;
+
         ///
         /// \brief map the given values to weights
         ///
@@ -43,6 +49,8 @@ namespace nano
 
     private:
 
+        scalar_t evaluate(const vector_t& x, const indices_cmap_t* summands, vector_t* gx) const;
+
         // attributes
         const loss_t&       m_loss;         ///<
         const tensor4d_t&   m_targets;      ///< (#samples, ...) targets
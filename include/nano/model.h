@@ -195,6 +195,9 @@ namespace nano
         ///
         /// \brief evaluate the trained model and returns the error for each of the given samples.
         ///
+        /// NB: the samples are processed batch-by-batch in parallel (predictions, targets and errors)
+        ///     so that the predictions of all samples are never stored at once.
+        ///
         tensor1d_t evaluate(const loss_t&, const dataset_t&, const indices_t&) const;
 
         ///
@@ -202,6 +205,13 @@ namespace nano
         ///
         virtual tensor4d_t predict(const dataset_t&, const indices_t&) const = 0;
 
+        ///
+        /// \brief evaluate the trained model and writes the predictions for the given (batch of) samples.
+        ///
+        /// NB: this is called from within a parallel loop (@see evaluate), so it should not be parallelized.
+        ///
+        virtual void predict(const dataset_t&, const indices_cmap_t&, tensor4d_map_t outputs) const = 0;
+
         ///
         /// \brief register new parameters.
         ///
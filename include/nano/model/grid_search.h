@@ -95,6 +95,11 @@ namespace nano
         ///
         tensor4d_t predict(const dataset_t&, const indices_t&) const override;
 
+        ///
+        /// \brief @see model_t
+        ///
+        void predict(const dataset_t&, const indices_cmap_t&, tensor4d_map_t outputs) const override;
+
         ///
         /// \brief return the evaluated hyper-parameter configurations with the associated cross-validation error.
         ///
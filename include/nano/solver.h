@@ -1,5 +1,6 @@
 #pragma once
 
+#include <nano/chrono.h>
 #include <nano/lsearch0.h>
 #include <nano/lsearchk.h>
 #include <nano/solver/function.h>
@@ -36,8 +37,16 @@ namespace nano
             assert(m_lsearch0);
             assert(m_lsearchk);
 
+            // NB: the time since the previous line-search is spent updating the descent direction
+            state.m_dtime += m_timer.nanoseconds().count();
+            m_timer.reset();
+
             const auto t0 = m_lsearch0->get(state);
-            return m_lsearchk->get(state, t0);
+            const auto ok = m_lsearchk->get(state, t0);
+
+            state.m_ltime += m_timer.nanoseconds().count();
+            m_timer.reset();
+            return ok;
         }
 
     private:
@@ -45,6 +54,7 @@ namespace nano
         // attributes
         rlsearch0_t         m_lsearch0;     ///< procedure to guess the initial step length
         rlsearchk_t         m_lsearchk;     ///< procedure to adjust the step length
+        mutable nano::timer_t m_timer;      ///< measure the time spent in and in between line-searches
     };
 
     ///
@@ -62,6 +72,9 @@ namespace nano
         ///
         /// logging operator: op(state), returns false if the optimization should stop
         ///
+        /// NB: the state provides the cost of the optimization so far
+        ///     (e.g. the number of function calls, the time spent in line-search or evaluating the function).
+        ///
         using logger_t = std::function<bool(const solver_state_t&)>;
 
         ///
@@ -105,6 +118,35 @@ namespace nano
         ///
         solver_state_t minimize(const function_t&, const vector_t& x0) const;
 
+        ///
+        /// \brief minimize the given function starting from the initial point x0
+        ///     subject to the box constraints: lower <= x <= upper.
+        ///
+        /// NB: the bounds can be infinite and the initial point is projected onto the feasible set.
+        /// NB: only the bound-constrained solvers (@see bounded) support this method.
+        ///
+        solver_state_t minimize(
+            const function_t&, const vector_t& x0, const vector_t& lower, const vector_t& upper) const;
+
+        ///
+        /// \brief minimize the given function starting independently from each of the given initial points
+        ///     and return the resulting states sorted by the function value (best first).
+        ///
+        /// NB: the minimizations are run concurrently using the thread pool,
+        ///     so the function (and the logging callback if any) must support concurrent evaluation.
+        ///
+        /// NB: the remaining minimizations are stopped (or skipped) as soon as any of them
+        ///     reaches the target function value (if given).
+        ///
+        std::vector<solver_state_t> minimize_many(
+            const function_t&, const std::vector<vector_t>& x0s,
+            scalar_t ftarget = -std::numeric_limits<scalar_t>::infinity()) const;
+
+        ///
+        /// \brief returns true if the solver supports bound constraints
+        ///
+        virtual bool bounded() const { return false; }
+
         ///
         /// \brief set the logging callback
         ///
@@ -171,8 +213,18 @@ namespace nano
         ///
         bool done(const solver_function_t& function, solver_state_t& state, bool iter_ok) const;
 
+        ///
+        /// \brief check if the optimization is done using the given convergence status
+        ///     (e.g. the projected gradient is small for bound-constrained problems)
+        ///
+        bool done(const solver_function_t& function, solver_state_t& state, bool iter_ok, bool converged) const;
+
     private:
 
+        solver_state_t minimize_one(
+            const function_t&, const vector_t& x0, const vector_t& lower, const vector_t& upper,
+            std::atomic<bool>* stop, scalar_t ftarget) const;
+
         // attributes
         sparam1_t       m_epsilon{"solver::epsilon", 0, LT, 1e-6, LE, 1e-3};        ///< desired accuracy
         iparam1_t       m_max_iterations{"solver::maxiters", 1, LE, 1000, LT, 1e+6};///< maximum number of iterations
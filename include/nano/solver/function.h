@@ -1,11 +1,29 @@
 #pragma once
 
+#include <atomic>
+#include <cstring>
+#include <algorithm>
+#include <nano/chrono.h>
 #include <nano/function.h>
 
 namespace nano
 {
     ///
-    /// \brief wrapper over function_t to keep track of the number of function value and gradient calls.
+    /// \brief wrapper over function_t to keep track of the number of function value, gradient
+    ///     and Hessian-vector product calls.
+    ///
+    /// NB: the results of the most recent function value (and gradient) calls are memoized in a small LRU cache,
+    ///     as the line-search procedures may evaluate the function multiple times at the same point
+    ///     (e.g. the initial point or the best bracketed step length)
+    ///     and a function call can be very expensive (e.g. a full pass over the training samples).
+    ///
+    /// NB: only the calls that miss the cache are counted as function value and gradient evaluations.
+    /// NB: the partial evaluations (e.g. the mini-batches of the stochastic solvers) are counted separately.
+    ///
+    /// NB: the time spent evaluating the function and the number of bytes touched are also cumulated
+    ///     to break down the cost of the optimization (@see solver_state_t).
+    ///
+    /// NB: the cache and the counters are not synchronized and thus the function must not be evaluated concurrently.
     ///
     class solver_function_t final : public function_t
     {
@@ -14,9 +32,10 @@ namespace nano
         ///
         /// \brief constructor
         ///
-        explicit solver_function_t(const function_t& function) :
+        explicit solver_function_t(const function_t& function, const size_t cache_size = 4) :
             function_t(function),
-            m_function(function)
+            m_function(function),
+            m_cache(cache_size)
         {
         }
 
@@ -25,9 +44,149 @@ namespace nano
         ///
         scalar_t vgrad(const vector_t& x, vector_t* gx = nullptr) const override
         {
+            const auto xhash = hash(x);
+
+            // NB: the cache entries are ordered from the most to the least recently used
+            const auto begin = m_cache.begin(), end = m_cache.begin() + static_cast<std::ptrdiff_t>(m_cached);
+            auto it = std::find_if(begin, end, [&] (const entry_t& entry)
+            {
+                return entry.m_hash == xhash && entry.m_x.size() == x.size() && entry.m_x == x;
+            });
+
+            if (it != end && (gx == nullptr || it->m_has_g))
+            {
+                m_hits += 1;
+                if (gx != nullptr)
+                {
+                    *gx = it->m_g;
+                }
+                std::rotate(begin, it, it + 1);
+                return begin->m_f;
+            }
+
+            m_misses += 1;
             m_fcalls += 1;
             m_gcalls += (gx != nullptr) ? 1 : 0;
-            return m_function.vgrad(x, gx);
+
+            const nano::timer_t timer;
+            const auto fx = m_function.vgrad(x, gx);
+            evaluated(timer, m_function.bytes());
+
+            if (!m_cache.empty())
+            {
+                // NB: overwrite either the entry of the same point (without gradient) or the least recently used one
+                if (it == end)
+                {
+                    m_cached = std::min(m_cached + 1, m_cache.size());
+                    it = begin + static_cast<std::ptrdiff_t>(m_cached - 1);
+                }
+
+                it->m_hash = xhash;
+                it->m_x = x;
+                it->m_f = fx;
+                it->m_has_g = (gx != nullptr);
+                if (gx != nullptr)
+                {
+                    it->m_g = *gx;
+                }
+                std::rotate(begin, it, it + 1);
+            }
+
+            return fx;
+        }
+
+        ///
+        /// \brief @see function_t
+        ///
+        tensor_size_t summands() const override
+        {
+            return m_function.summands();
+        }
+
+        ///
+        /// \brief @see function_t
+        ///
+        /// NB: the partial evaluations are not memoized, as they depend on the given subset of terms.
+        ///
+        scalar_t partial_vgrad(const vector_t& x, const indices_cmap_t& summands, vector_t* gx = nullptr) const override
+        {
+            m_pcalls += 1;
+
+            const nano::timer_t timer;
+            const auto fx = m_function.partial_vgrad(x, summands, gx);
+            evaluated(timer, m_function.bytes() * summands.size() / std::max(m_function.summands(), tensor_size_t(1)));
+            return fx;
+        }
+
+        ///
+        /// \brief @see function_t
+        ///
+        void hvp(const vector_t& x, const vector_t& v, vector_t& hv) const override
+        {
+            m_hcalls += 1;
+
+            const nano::timer_t timer;
+            m_function.hvp(x, v, hv);
+            evaluated(timer, m_function.hvp_bytes());
+        }
+
+        ///
+        /// \brief @see function_t
+        ///
+        tensor_size_t bytes() const override
+        {
+            return m_function.bytes();
+        }
+
+        ///
+        /// \brief @see function_t
+        ///
+        tensor_size_t hvp_bytes() const override
+        {
+            return m_function.hvp_bytes();
+        }
+
+        ///
+        /// \brief set the box constraints (if any): lower <= x <= upper
+        ///
+        /// NB: empty bounds mean an unconstrained problem.
+        ///
+        void bounds(const vector_t& lower, const vector_t& upper)
+        {
+            m_lower = lower;
+            m_upper = upper;
+        }
+
+        ///
+        /// \brief returns the lower and the upper bounds (empty if unconstrained)
+        ///
+        const auto& lower() const { return m_lower; }
+        const auto& upper() const { return m_upper; }
+
+        ///
+        /// \brief share a stopping flag with other (concurrent) minimizations,
+        ///     raised as soon as any of them reaches the given target function value.
+        ///
+        void stopping(std::atomic<bool>* stop, const scalar_t ftarget)
+        {
+            m_stop = stop;
+            m_ftarget = ftarget;
+        }
+
+        ///
+        /// \brief returns true if the minimization should stop given the current function value
+        ///
+        bool stopped(const scalar_t fx) const
+        {
+            if (m_stop == nullptr)
+            {
+                return false;
+            }
+            if (fx <= m_ftarget)
+            {
+                m_stop->store(true);
+            }
+            return m_stop->load();
         }
 
         ///
@@ -40,11 +199,81 @@ namespace nano
         ///
         auto gcalls() const { return m_gcalls; }
 
+        ///
+        /// \brief number of Hessian-vector product calls
+        ///
+        auto hcalls() const { return m_hcalls; }
+
+        ///
+        /// \brief number of partial function value (and gradient) calls
+        ///
+        auto pcalls() const { return m_pcalls; }
+
+        ///
+        /// \brief number of function calls served from the cache (hits) or evaluated (misses)
+        ///
+        auto hits() const { return m_hits; }
+        auto misses() const { return m_misses; }
+
+        ///
+        /// \brief time spent evaluating the function and number of bytes touched by the evaluations
+        ///
+        auto ftime() const { return m_ftime; }
+        auto fbytes() const { return m_fbytes; }
+
+        ///
+        /// \brief wall time since the construction (the start of the optimization)
+        ///
+        auto elapsed() const { return m_timer.nanoseconds().count(); }
+
     private:
 
+        struct entry_t
+        {
+            size_t      m_hash{0};          ///< hash of the point
+            vector_t    m_x;                ///< point
+            vector_t    m_g;                ///< gradient at the point (if evaluated)
+            scalar_t    m_f{0};             ///< function value at the point
+            bool        m_has_g{false};     ///<
+        };
+
+        void evaluated(const nano::timer_t& timer, const tensor_size_t bytes) const
+        {
+            m_ftime += timer.nanoseconds().count();
+            m_fbytes += bytes;
+        }
+
+        static size_t hash(const vector_t& x)
+        {
+            // FNV-1a hash of the binary representation (processed per 64-bit word)
+            static_assert(sizeof(scalar_t) <= sizeof(uint64_t));
+
+            uint64_t h = 14695981039346656037ULL;
+            for (tensor_size_t i = 0; i < x.size(); ++ i)
+            {
+                uint64_t word = 0;
+                std::memcpy(&word, x.data() + i, sizeof(scalar_t));
+                h ^= word;
+                h *= 1099511628211ULL;
+            }
+            return static_cast<size_t>(h);
+        }
+
         // attributes
         const function_t&       m_function;             ///<
         mutable tensor_size_t   m_fcalls{0};            ///< #function value evaluations
         mutable tensor_size_t   m_gcalls{0};            ///< #function gradient evaluations
+        mutable tensor_size_t   m_hcalls{0};            ///< #Hessian-vector product evaluations
+        mutable tensor_size_t   m_pcalls{0};            ///< #partial function value (and gradient) evaluations
+        mutable tensor_size_t   m_hits{0};              ///< #function calls served from the cache
+        mutable tensor_size_t   m_misses{0};            ///< #function calls not found in the cache
+        mutable int64_t         m_ftime{0};             ///< time spent evaluating the function [ns]
+        mutable tensor_size_t   m_fbytes{0};            ///< #bytes touched by the function evaluations
+        nano::timer_t           m_timer;                ///< measure the wall time since the construction
+        mutable std::vector<entry_t> m_cache;           ///< cached function calls (most recently used first)
+        mutable size_t          m_cached{0};            ///< #valid cache entries
+        vector_t                m_lower, m_upper;       ///< box constraints (if any)
+        std::atomic<bool>*      m_stop{nullptr};        ///< shared stopping flag (if any)
+        scalar_t                m_ftarget{0};           ///< target function value to raise the stopping flag
     };
 }
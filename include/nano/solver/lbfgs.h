@@ -8,6 +8,11 @@ namespace nano
     /// \brief limited memory BGFS (l-BGFS).
     ///     see "Updating Quasi-Newton Matrices with Limited Storage", by J. Nocedal, 1980
     ///     see "Numerical Optimization", by J. Nocedal, S. Wright, 2006
+    ///     see "Representations of quasi-Newton matrices and their use in limited memory methods",
+    ///         by R. Byrd, J. Nocedal, R. Schnabel, 1994
+    ///
+    /// NB: the history of the updates is stored in two preallocated (#history, #dims) matrices used as a ring buffer,
+    ///     so that no memory is allocated while iterating.
     ///
     class NANO_PUBLIC solver_lbfgs_t final : public solver_t
     {
@@ -15,6 +20,15 @@ namespace nano
 
         using solver_t::minimize;
 
+        ///
+        /// \brief methods to compute the descent direction from the history of updates.
+        ///
+        enum class representation
+        {
+            recursive,      ///< the classical two-loop recursion (BLAS-1 operations)
+            compact,        ///< the compact matrix representation (BLAS-2 operations)
+        };
+
         ///
         /// \brief default constructor
         ///
@@ -29,15 +43,28 @@ namespace nano
         /// \brief change parameters
         ///
         void history(const size_t history) { m_history = history; }
+        void repr(const representation repr) { m_representation = repr; }
 
         ///
         /// \brief access functions
         ///
         auto history() const { return m_history.get(); }
+        auto repr() const { return m_representation; }
 
     private:
 
         // attributes
-        uparam1_t   m_history{"solver::lbfgs::history", 1, LE, 6, LE, 1000};///<#previous gradients to approximate Hessian^-1
+        uparam1_t       m_history{"solver::lbfgs::history", 1, LE, 6, LE, 1000};///<#previous gradients to approximate Hessian^-1
+        representation  m_representation{representation::recursive};           ///<
     };
+
+    template <>
+    inline enum_map_t<solver_lbfgs_t::representation> enum_string<solver_lbfgs_t::representation>()
+    {
+        return
+        {
+            { solver_lbfgs_t::representation::recursive,    "recursive" },
+            { solver_lbfgs_t::representation::compact,      "compact" }
+        };
+    }
 }
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <nano/solver.h>
+
+namespace nano
+{
+    ///
+    /// \brief limited memory BGFS with box constraints (l-BFGS-B): lower <= x <= upper.
+    ///     see "A limited memory algorithm for bound constrained optimization",
+    ///         by R. Byrd, P. Lu, J. Nocedal, C. Zhu, 1995
+    ///     see "Representations of quasi-Newton matrices and their use in limited memory methods",
+    ///         by R. Byrd, J. Nocedal, R. Schnabel, 1994
+    ///
+    /// NB: each iteration consists of:
+    ///     - the generalized Cauchy point: the first local minimizer of the quadratic model
+    ///         along the projected gradient path,
+    ///     - the subspace minimization of the quadratic model over the variables not at their bounds
+    ///         (truncated to stay feasible) and
+    ///     - the line-search along the direction to the resulting point.
+    ///
+    /// NB: the step length is capped to 1 to keep the iterates feasible,
+    ///     so a backtracking line-search (Armijo conditions) is used by default.
+    ///
+    /// NB: the convergence criterion uses the projected gradient, which is equivalent to
+    ///     the regular gradient if the problem is unconstrained (or the bounds are infinite).
+    ///
+    class NANO_PUBLIC solver_lbfgsb_t final : public solver_t
+    {
+    public:
+
+        using solver_t::minimize;
+
+        ///
+        /// \brief default constructor
+        ///
+        solver_lbfgsb_t();
+
+        ///
+        /// \brief @see solver_t
+        ///
+        bool bounded() const final { return true; }
+
+        ///
+        /// \brief @see lsearch_solver_t
+        ///
+        solver_state_t iterate(const solver_function_t&, const lsearch_t&, const vector_t& x0) const final;
+
+        ///
+        /// \brief change parameters
+        ///
+        void history(const size_t history) { m_history = history; }
+
+        ///
+        /// \brief access functions
+        ///
+        auto history() const { return m_history.get(); }
+
+    private:
+
+        // attributes
+        uparam1_t       m_history{"solver::lbfgsb::history", 1, LE, 6, LE, 1000};///< #previous updates
+    };
+}
@@ -29,7 +29,7 @@ namespace nano
         lsearch_step_t(lsearch_step_t&&) noexcept = default;
         lsearch_step_t(const lsearch_step_t&) = default;
         // cppcheck-suppress noExplicitConstructor
-        lsearch_step_t(const solver_state_t& state) : t(state.t), f(state.f), g(state.dg()) {} // NOLINT(hicpp-explicit-conversions)
+        lsearch_step_t(const solver_state_t& state) : t(state.t), f(state.f), g(slope(state)) {} // NOLINT(hicpp-explicit-conversions)
         lsearch_step_t(const scalar_t tt, const scalar_t ff, const scalar_t gg) : t(tt), f(ff), g(gg) {}
 
         ///
@@ -39,10 +39,21 @@ namespace nano
         lsearch_step_t& operator=(const lsearch_step_t&) = default;
         lsearch_step_t& operator=(const solver_state_t& state)
         {
-            t = state.t, f = state.f, g = state.dg();
+            t = state.t, f = state.f, g = slope(state);
             return *this;
         }
 
+        ///
+        /// \brief returns the line-search slope of the given state (if its gradient is evaluated), otherwise NaN.
+        ///
+        /// NB: the interpolation methods using the unknown slope fall back to the ones using only function values
+        ///     (e.g. cubic -> quadratic).
+        ///
+        static scalar_t slope(const solver_state_t& state)
+        {
+            return state.m_has_grad ? state.dg() : std::numeric_limits<scalar_t>::quiet_NaN();
+        }
+
         ///
         /// \brief destructor
         ///
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <nano/solver.h>
+
+namespace nano
+{
+    ///
+    /// \brief truncated Newton method (aka Hessian-free Newton-CG) with line-search.
+    ///     see "Numerical Optimization", by J. Nocedal, S. Wright, 2006 - algorithm 7.1
+    ///     see "Truncated-Newton algorithms for large-scale unconstrained optimization", by R. Dembo, T. Steihaug, 1983
+    ///
+    /// NB: the Newton system is solved approximately with the conjugate gradient method
+    ///     using only Hessian-vector products (@see function_t::hvp), so the Hessian is never stored.
+    ///
+    /// NB: the conjugate gradient iterations are stopped:
+    ///     - when the residual is small enough relative to the gradient (the forcing sequence) or
+    ///     - when a direction of non-positive curvature is detected or
+    ///     - when the maximum number of conjugate gradient iterations is reached.
+    ///
+    class NANO_PUBLIC solver_newton_t final : public solver_t
+    {
+    public:
+
+        using solver_t::minimize;
+
+        ///
+        /// \brief default constructor
+        ///
+        solver_newton_t();
+
+        ///
+        /// \brief @see lsearch_solver_t
+        ///
+        solver_state_t iterate(const solver_function_t&, const lsearch_t&, const vector_t& x0) const final;
+
+        ///
+        /// \brief change parameters
+        ///
+        void cgiters(const size_t cgiters) { m_cgiters = cgiters; }
+        void forcing(const scalar_t forcing) { m_forcing = forcing; }
+
+        ///
+        /// \brief access functions
+        ///
+        auto cgiters() const { return m_cgiters.get(); }
+        auto forcing() const { return m_forcing.get(); }
+
+    private:
+
+        // attributes
+        uparam1_t   m_cgiters{"solver::newton::cgiters", 1, LE, 100, LE, 10000};///< maximum #conjugate gradient iterations
+        sparam1_t   m_forcing{"solver::newton::forcing", 0, LT, 0.5, LT, 1};   ///< upper bound of the forcing sequence
+    };
+}
@@ -12,6 +12,10 @@ namespace nano
     ///     descent direction (d),
     ///     line-search step (t).
     ///
+    /// NB: the wall time is broken down into the time spent in line-search and
+    ///     the time spent updating the descent direction (in between line-searches),
+    ///     both including the function evaluations performed meanwhile (@see m_ftime).
+    ///
     class solver_state_t
     {
     public:
@@ -53,6 +57,7 @@ namespace nano
             assert(x.size() == function->size());
             x = xx;
             f = function->vgrad(x, &g);
+            m_has_grad = true;
             return static_cast<bool>(*this);
         }
 
@@ -65,6 +70,39 @@ namespace nano
             return update(state0.x + t * state0.d);
         }
 
+        ///
+        /// \brief line-search step along the descent direction of state0,
+        ///     but evaluate only the function value (e.g. to check the Armijo condition).
+        ///
+        /// NB: the gradient is evaluated on demand (@see update_grad),
+        ///     as it can be much more expensive than the function value (e.g. for machine learning models).
+        ///
+        bool update_value(const solver_state_t& state0, const scalar_t tt)
+        {
+            assert(function);
+            assert(x.size() == state0.x.size());
+            assert(x.size() == function->size());
+            t = tt;
+            x = state0.x + t * state0.d;
+            f = function->vgrad(x, nullptr);
+            m_has_grad = false;
+            return static_cast<bool>(*this);
+        }
+
+        ///
+        /// \brief evaluate the gradient at the current point (if not already evaluated).
+        ///
+        bool update_grad()
+        {
+            assert(function);
+            if (!m_has_grad)
+            {
+                f = function->vgrad(x, &g);
+                m_has_grad = true;
+            }
+            return static_cast<bool>(*this);
+        }
+
         ///
         /// \brief check convergence: the gradient is relatively small
         ///
@@ -86,7 +124,7 @@ namespace nano
         ///
         operator bool() const // NOLINT(hicpp-explicit-conversions)
         {
-            return std::isfinite(t) && std::isfinite(f) && std::isfinite(convergence_criterion());
+            return std::isfinite(t) && std::isfinite(f) && (!m_has_grad || std::isfinite(convergence_criterion()));
         }
 
         ///
@@ -159,7 +197,17 @@ namespace nano
         status              m_status{status::max_iters};    ///< optimization status
         tensor_size_t       m_fcalls{0};            ///< #function value evaluations so far
         tensor_size_t       m_gcalls{0};            ///< #function gradient evaluations so far
+        tensor_size_t       m_hcalls{0};            ///< #Hessian-vector product evaluations so far
+        tensor_size_t       m_pcalls{0};            ///< #partial function evaluations so far (e.g. mini-batches)
+        tensor_size_t       m_hits{0};              ///< #function calls served from the cache so far
+        tensor_size_t       m_misses{0};            ///< #function calls not found in the cache so far
         tensor_size_t       m_iterations{0};        ///< #optimization iterations so far
+        int64_t             m_time{0};              ///< wall time so far [ns]
+        int64_t             m_ftime{0};             ///< time spent evaluating the function so far [ns]
+        int64_t             m_ltime{0};             ///< time spent in line-search so far [ns]
+        int64_t             m_dtime{0};             ///< time spent updating the descent direction so far [ns]
+        tensor_size_t       m_fbytes{0};            ///< #bytes touched by the function evaluations so far
+        bool                m_has_grad{true};       ///< the gradient is evaluated at the current point
     };
 
     template <>
@@ -187,7 +235,11 @@ namespace nano
 
     inline std::ostream& operator<<(std::ostream& os, const solver_state_t& state)
     {
-        return os << "iters=" << state.m_iterations << ",calls=" << state.m_fcalls << "|" << state.m_gcalls
-                << ",fx=" << state.f << ",gx=" << state.convergence_criterion() << ",status=" << state.m_status;
+        os << "iters=" << state.m_iterations << ",calls=" << state.m_fcalls << "|" << state.m_gcalls;
+        if (state.m_pcalls > 0)
+        {
+            os << ",pcalls=" << state.m_pcalls;
+        }
+        return os << ",fx=" << state.f << ",gx=" << state.convergence_criterion() << ",status=" << state.m_status;
     }
 }
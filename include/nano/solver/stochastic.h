@@ -0,0 +1,185 @@
+#pragma once
+
+#include <nano/random.h>
+#include <nano/solver.h>
+
+namespace nano
+{
+    ///
+    /// \brief stochastic (mini-batch) solvers for sample-decomposable functions (@see function_t::partial_vgrad).
+    ///
+    /// NB: an iteration consists of an epoch, where the shuffled samples are processed in mini-batches,
+    ///     followed by a full evaluation of the function (to check convergence).
+    /// NB: the mini-batches are processed in order, as each update depends on the previous one,
+    ///     but the evaluation of a mini-batch is split across the thread pool (@see linear_function_t).
+    /// NB: the mini-batch evaluations are counted separately from the full function evaluations
+    ///     (@see solver_state_t::m_pcalls).
+    /// NB: the line-search parameters are not used, the step size is given by the learning rate instead.
+    /// NB: the functions that are not sample-decomposable are processed as a single mini-batch
+    ///     (e.g. the SGD becomes a gradient descent method with a fixed step size).
+    ///
+    class NANO_PUBLIC solver_stochastic_t : public solver_t
+    {
+    public:
+
+        using solver_t::minimize;
+
+        ///
+        /// \brief default constructor
+        ///
+        solver_stochastic_t();
+
+        ///
+        /// \brief change parameters
+        ///
+        void batch(const int64_t batch) { m_batch = batch; }
+        void lrate(const scalar_t lrate) { m_lrate = lrate; }
+
+        ///
+        /// \brief access functions
+        ///
+        auto batch() const { return m_batch.get(); }
+        auto lrate() const { return m_lrate.get(); }
+
+    protected:
+
+        ///
+        /// \brief process the mini-batches of shuffled samples epoch by epoch, where
+        ///     the operator op(snapshot, samples, x) updates the current point x using the given mini-batch.
+        ///
+        /// NB: the snapshot is the optimization state evaluated (on all samples) at the end of the previous epoch.
+        ///
+        template <typename toperator>
+        solver_state_t loop(const solver_function_t& function, const vector_t& x0, const toperator& op) const
+        {
+            auto cstate = solver_state_t{function, x0};
+            if (solver_t::done(function, cstate, true))
+            {
+                return cstate;
+            }
+
+            auto rng = make_rng();
+            auto samples = arange(0, function.summands());
+            const auto batch = static_cast<tensor_size_t>(this->batch());
+
+            vector_t x = cstate.x;
+            for (int64_t i = 0; i < max_iterations(); ++ i)
+            {
+                std::shuffle(samples.begin(), samples.end(), rng);
+                for (tensor_size_t begin = 0; begin < samples.size(); begin += batch)
+                {
+                    const auto end = std::min(begin + batch, samples.size());
+                    op(cstate, samples.slice(begin, end), x);
+                }
+
+                cstate.t = 1;
+                cstate.d = x - cstate.x;
+                const auto iter_ok = cstate.update(x);
+                if (solver_t::done(function, cstate, iter_ok))
+                {
+                    break;
+                }
+            }
+
+            return cstate;
+        }
+
+    private:
+
+        // attributes
+        iparam1_t   m_batch{"solver::stochastic::batch", 1, LE, 32, LE, 1e+6};     ///< mini-batch size
+        sparam1_t   m_lrate{"solver::stochastic::lrate", 0, LT, 1e-2, LE, 1e+3};   ///< learning rate
+    };
+
+    ///
+    /// \brief stochastic gradient descent with (heavy-ball) momentum.
+    ///     see "On the importance of initialization and momentum in deep learning", by I. Sutskever et al.
+    ///
+    class NANO_PUBLIC solver_sgd_t final : public solver_stochastic_t
+    {
+    public:
+
+        ///
+        /// \brief default constructor
+        ///
+        solver_sgd_t();
+
+        ///
+        /// \brief @see solver_t
+        ///
+        solver_state_t iterate(const solver_function_t&, const lsearch_t&, const vector_t& x0) const final;
+
+        ///
+        /// \brief change parameters
+        ///
+        void momentum(const scalar_t momentum) { m_momentum = momentum; }
+
+        ///
+        /// \brief access functions
+        ///
+        auto momentum() const { return m_momentum.get(); }
+
+    private:
+
+        // attributes
+        sparam1_t   m_momentum{"solver::sgd::momentum", 0, LE, 0.9, LT, 1};        ///<
+    };
+
+    ///
+    /// \brief adaptive moment estimation.
+    ///     see "Adam: A Method for Stochastic Optimization", by D. P. Kingma & J. Ba
+    ///
+    class NANO_PUBLIC solver_adam_t final : public solver_stochastic_t
+    {
+    public:
+
+        ///
+        /// \brief default constructor
+        ///
+        solver_adam_t();
+
+        ///
+        /// \brief @see solver_t
+        ///
+        solver_state_t iterate(const solver_function_t&, const lsearch_t&, const vector_t& x0) const final;
+
+        ///
+        /// \brief change parameters
+        ///
+        void beta1(const scalar_t beta1) { m_beta1 = beta1; }
+        void beta2(const scalar_t beta2) { m_beta2 = beta2; }
+
+        ///
+        /// \brief access functions
+        ///
+        auto beta1() const { return m_beta1.get(); }
+        auto beta2() const { return m_beta2.get(); }
+
+    private:
+
+        // attributes
+        sparam1_t   m_beta1{"solver::adam::beta1", 0, LE, 0.9, LT, 1};             ///< decay rate of the first momentum
+        sparam1_t   m_beta2{"solver::adam::beta2", 0, LE, 0.999, LT, 1};           ///< decay rate of the second momentum
+    };
+
+    ///
+    /// \brief stochastic variance reduced gradient.
+    ///     see "Accelerating Stochastic Gradient Descent using Predictive Variance Reduction", by R. Johnson & T. Zhang
+    ///
+    /// NB: the full gradient evaluated at the end of each epoch is used as the snapshot for the next epoch.
+    ///
+    class NANO_PUBLIC solver_svrg_t final : public solver_stochastic_t
+    {
+    public:
+
+        ///
+        /// \brief default constructor
+        ///
+        solver_svrg_t();
+
+        ///
+        /// \brief @see solver_t
+        ///
+        solver_state_t iterate(const solver_function_t&, const lsearch_t&, const vector_t& x0) const final;
+    };
+}
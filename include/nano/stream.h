@@ -206,6 +206,11 @@ namespace nano
         auto minor_version() const { return m_minor_version; }
         auto patch_version() const { return m_patch_version; }
 
+        ///
+        /// \brief returns true if the object was serialized with the given version or a more recent one.
+        ///
+        bool serialized_since(int32_t major_version, int32_t minor_version, int32_t patch_version) const;
+
     private:
 
         // attributes
@@ -60,11 +60,18 @@ namespace nano
         ///
         explicit tpool_worker_t(tpool_queue_t& queue) : m_queue(queue) {}
 
+        ///
+        /// \brief returns true if the calling thread is a worker thread of the pool
+        ///
+        static bool current() { return flag(); }
+
         ///
         /// \brief execute tasks when available
         ///
         void operator()() const
         {
+            flag() = true;
+
             while (true)
             {
                 tpool_task_t task;
@@ -96,6 +103,12 @@ namespace nano
 
     private:
 
+        static bool& flag()
+        {
+            static thread_local bool flag = false;
+            return flag;
+        }
+
         // attributes
         tpool_queue_t&          m_queue;        ///< task queue to process
     };
@@ -236,6 +249,8 @@ namespace nano
     ///
     /// \brief split a loop computation of the given size in fixed-sized chunks using a thread pool.
     /// NB: the operator receives the range [begin, end) to process and the assigned thread index: op(begin, end, tnum)
+    /// NB: the loop is run sequentially if called from a worker thread (nested loops),
+    ///     as the thread pool would deadlock otherwise.
     ///
     template <typename tsize, typename tchunk_, typename toperator>
     void loopr(const tsize size, const tchunk_ chunk_, const toperator& op)
@@ -245,6 +260,15 @@ namespace nano
         assert(size >= tsize(0));
         assert(chunk >= tsize(1));
 
+        if (tpool_worker_t::current())
+        {
+            for (tsize begin = 0; begin < size; begin += chunk)
+            {
+                op(begin, std::min(begin + chunk, size), tsize(0));
+            }
+            return;
+        }
+
         auto& pool = tpool_t::instance();
         const auto workers = static_cast<tsize>(tpool_t::size());
         const auto tchunk = std::max((size + workers - 1) / workers, chunk);
@@ -267,12 +291,23 @@ namespace nano
     ///
     /// \brief split a loop computation of the given size using a thread pool.
     /// NB: the operator receives the index to process and the assigned thread index: op(index, tnum)
+    /// NB: the loop is run sequentially if called from a worker thread (nested loops),
+    ///     as the thread pool would deadlock otherwise.
     ///
     template <typename tsize, typename toperator>
     void loopi(const tsize size, const toperator& op)
     {
         assert(size >= tsize(0));
 
+        if (tpool_worker_t::current())
+        {
+            for (tsize index = 0; index < size; ++ index)
+            {
+                op(index, tsize(0));
+            }
+            return;
+        }
+
         auto& pool = tpool_t::instance();
         const auto workers = static_cast<tsize>(tpool_t::size());
         const auto tchunk = (size + workers - 1) / workers;
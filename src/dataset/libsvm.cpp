@@ -0,0 +1,168 @@
+#include <fstream>
+#include <nano/logger.h>
+#include <nano/tokenizer.h>
+#include <nano/mlearn/class.h>
+#include <nano/dataset/libsvm.h>
+
+using namespace nano;
+
+libsvm_dataset_t::libsvm_dataset_t(string_t path, const task_type task, const tensor_size_t features) :
+    m_path(std::move(path)),
+    m_task(task),
+    m_features(features)
+{
+}
+
+void libsvm_dataset_t::load()
+{
+    critical(
+        m_task == task_type::unsupervised,
+        "libsvm dataset: the libsvm format requires labeled samples!");
+
+    critical(
+        m_features < 0,
+        scat("libsvm dataset: invalid number of features (", m_features, ")!"));
+
+    log_info() << "libsvm dataset: reading " << m_path << "...";
+
+    std::vector<strings_t> labels;
+    std::vector<tensor_size_t> offsets{0};
+    std::vector<std::pair<tensor_size_t, scalar_t>> values, svalues;
+
+    string_t line;
+    tensor_size_t max_index = 0;
+    tensor_size_t line_index = 0;
+    for (std::ifstream stream(m_path); std::getline(stream, line); ++ line_index)
+    {
+        const auto comment = line.find('#');
+        if (comment != string_t::npos)
+        {
+            line.erase(comment);
+        }
+
+        svalues.clear();
+        for (auto tokenizer = tokenizer_t{line, " \t\r"}; tokenizer; ++ tokenizer)
+        {
+            const auto token = tokenizer.get();
+            if (tokenizer.count() == 1)
+            {
+                auto& slabels = labels.emplace_back();
+                for (auto ltokenizer = tokenizer_t{token, ","}; ltokenizer; ++ ltokenizer)
+                {
+                    slabels.push_back(ltokenizer.get());
+                }
+                continue;
+            }
+
+            const auto delim = token.find(':');
+            critical(
+                delim == string_t::npos,
+                scat("libsvm dataset: invalid token [", token, "] at ", m_path, ":", line_index,
+                     ", expecting <feature index>:<feature value>!"));
+
+            const auto index = from_string<tensor_size_t>(token.substr(0, delim));
+            const auto value = from_string<scalar_t>(token.substr(delim + 1));
+            critical(
+                index < 1,
+                scat("libsvm dataset: invalid feature index ", index, " at ", m_path, ":", line_index,
+                     ", expecting one-based feature indices!"));
+
+            const auto findex = (m_features > 0) ? ((index - 1) % m_features) : (index - 1);
+            svalues.emplace_back(findex, value);
+            max_index = std::max(max_index, findex + 1);
+        }
+
+        if (svalues.empty() && labels.size() < offsets.size())
+        {
+            // NB: empty line or comment only
+            continue;
+        }
+
+        critical(
+            labels.size() != offsets.size() || labels.back().empty(),
+            scat("libsvm dataset: missing label at ", m_path, ":", line_index, "!"));
+
+        // NB: sort the feature values by feature index and sum the values of the same (hashed) feature index
+        std::sort(svalues.begin(), svalues.end(), [] (const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+        for (const auto& svalue : svalues)
+        {
+            if (values.size() > static_cast<size_t>(offsets.back()) && values.back().first == svalue.first)
+            {
+                values.back().second += svalue.second;
+            }
+            else
+            {
+                values.push_back(svalue);
+            }
+        }
+
+        offsets.push_back(static_cast<tensor_size_t>(values.size()));
+    }
+
+    const auto samples = static_cast<tensor_size_t>(labels.size());
+    const auto features = (m_features > 0) ? m_features : max_index;
+
+    critical(
+        samples == 0,
+        scat("libsvm dataset: no sample read from ", m_path, ", check path!"));
+
+    // map the labels to targets
+    auto target = feature_t{"target"};
+    auto targets = tensor4d_t{};
+    if (m_task == task_type::regression)
+    {
+        targets.resize(samples, 1, 1, 1);
+        for (tensor_size_t sample = 0; sample < samples; ++ sample)
+        {
+            const auto& slabels = labels[static_cast<size_t>(sample)];
+            critical(
+                slabels.size() != 1,
+                scat("libsvm dataset: expecting a single target value for sample ", sample, "!"));
+            targets(sample, 0, 0, 0) = from_string<scalar_t>(slabels[0]);
+        }
+    }
+    else
+    {
+        strings_t ulabels;
+        for (const auto& slabels : labels)
+        {
+            critical(
+                m_task == task_type::sclassification && slabels.size() != 1,
+                "libsvm dataset: expecting a single class label per sample!");
+            ulabels.insert(ulabels.end(), slabels.begin(), slabels.end());
+        }
+        std::sort(ulabels.begin(), ulabels.end());
+        ulabels.erase(std::unique(ulabels.begin(), ulabels.end()), ulabels.end());
+
+        const auto n_labels = static_cast<tensor_size_t>(ulabels.size());
+
+        targets.resize(samples, n_labels, 1, 1);
+        targets.constant(neg_target());
+        for (tensor_size_t sample = 0; sample < samples; ++ sample)
+        {
+            for (const auto& label : labels[static_cast<size_t>(sample)])
+            {
+                const auto it = std::lower_bound(ulabels.begin(), ulabels.end(), label);
+                targets(sample, it - ulabels.begin(), 0, 0) = pos_target();
+            }
+        }
+
+        target.labels(std::move(ulabels));
+    }
+
+    // store the inputs in the CSR format
+    indices_t soffsets(samples + 1), sfindices(static_cast<tensor_size_t>(values.size()));
+    tensor1d_t sfvalues(static_cast<tensor_size_t>(values.size()));
+
+    std::copy(offsets.begin(), offsets.end(), soffsets.begin());
+    for (size_t k = 0; k < values.size(); ++ k)
+    {
+        sfindices(static_cast<tensor_size_t>(k)) = values[k].first;
+        sfvalues(static_cast<tensor_size_t>(k)) = values[k].second;
+    }
+
+    store(std::move(soffsets), std::move(sfindices), std::move(sfvalues), features, std::move(targets), std::move(target));
+
+    log_info() << "libsvm dataset: read " << samples << " samples with " << features << " features and "
+        << nonzeros() << " non-zero feature values.";
+}
@@ -0,0 +1,112 @@
+#include <nano/logger.h>
+#include <nano/dataset/sparse.h>
+
+using namespace nano;
+
+sparse_dataset_t::sparse_dataset_t(
+    indices_t offsets, indices_t findices, tensor1d_t fvalues, const tensor_size_t features,
+    tensor4d_t targets, feature_t target)
+{
+    store(std::move(offsets), std::move(findices), std::move(fvalues), features, std::move(targets), std::move(target));
+}
+
+void sparse_dataset_t::load()
+{
+}
+
+void sparse_dataset_t::store(
+    indices_t offsets, indices_t findices, tensor1d_t fvalues, const tensor_size_t features,
+    tensor4d_t targets, feature_t target)
+{
+    const auto samples = targets.size<0>();
+
+    critical(
+        offsets.size() != samples + 1 || offsets(0) != 0 || offsets(samples) != findices.size(),
+        scat("sparse dataset: invalid offsets, expecting ", samples + 1, " offsets in the range [0, ",
+             findices.size(), "]!"));
+
+    critical(
+        findices.size() != fvalues.size(),
+        scat("sparse dataset: mismatching number of feature indices (", findices.size(),
+             ") and feature values (", fvalues.size(), ")!"));
+
+    for (tensor_size_t sample = 0; sample < samples; ++ sample)
+    {
+        const auto begin = offsets(sample), end = offsets(sample + 1);
+        critical(
+            begin > end,
+            scat("sparse dataset: invalid offsets for sample ", sample, "!"));
+
+        for (auto k = begin; k < end; ++ k)
+        {
+            critical(
+                findices(k) < 0 || findices(k) >= features || (k > begin && findices(k) <= findices(k - 1)),
+                scat("sparse dataset: invalid feature index ", findices(k), " for sample ", sample,
+                     ", expecting sorted feature indices in the range [0, ", features, ")!"));
+        }
+    }
+
+    m_offsets = std::move(offsets);
+    m_findices = std::move(findices);
+    m_fvalues = std::move(fvalues);
+    m_features = features;
+    m_targets = std::move(targets);
+    m_target = std::move(target);
+}
+
+feature_t sparse_dataset_t::feature(const tensor_size_t index) const
+{
+    assert(index >= 0 && index < m_features);
+
+    return feature_t{scat("feature_", index)};
+}
+
+tensor4d_t sparse_dataset_t::inputs(const indices_cmap_t& samples) const
+{
+    tensor4d_t inputs(cat_dims(samples.size(), idim()));
+    inputs.zero();
+
+    for (tensor_size_t i = 0; i < samples.size(); ++ i)
+    {
+        auto input = inputs.vector(i);
+        for (auto k = m_offsets(samples(i)), end = m_offsets(samples(i) + 1); k < end; ++ k)
+        {
+            input(m_findices(k)) = m_fvalues(k);
+        }
+    }
+
+    return inputs;
+}
+
+tensor1d_t sparse_dataset_t::inputs(const indices_cmap_t& samples, const tensor_size_t feature) const
+{
+    assert(feature >= 0 && feature < m_features);
+
+    tensor1d_t fvalues(samples.size());
+    for (tensor_size_t i = 0; i < samples.size(); ++ i)
+    {
+        const auto* const begin = m_findices.data() + m_offsets(samples(i));
+        const auto* const end = m_findices.data() + m_offsets(samples(i) + 1);
+        const auto* const it = std::lower_bound(begin, end, feature);
+
+        fvalues(i) = (it != end && *it == feature) ? m_fvalues(it - m_findices.data()) : scalar_t(0);
+    }
+
+    return fvalues;
+}
+
+tensor2d_t sparse_dataset_t::inputs(const indices_cmap_t& samples, const indices_t& features) const
+{
+    tensor2d_t fvalues(samples.size(), features.size());
+    for (tensor_size_t f = 0; f < features.size(); ++ f)
+    {
+        fvalues.matrix().col(f) = inputs(samples, features(f)).vector();
+    }
+
+    return fvalues;
+}
+
+tensor4d_t sparse_dataset_t::targets(const indices_cmap_t& samples) const
+{
+    return m_targets.indexed<scalar_t>(samples);
+}
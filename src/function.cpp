@@ -1,3 +1,5 @@
+#include <nano/tpool.h>
+#include <nano/random.h>
 #include <nano/function.h>
 #include <nano/function/trid.h>
 #include <nano/function/qing.h>
@@ -26,41 +28,160 @@ function_t::function_t(string_t name, const tensor_size_t size, const convexity
 {
 }
 
-scalar_t function_t::grad_accuracy(const vector_t& x) const
+scalar_t function_t::partial_vgrad(const vector_t& x, const indices_cmap_t& summands, vector_t* gx) const
+{
+    assert(summands.size() > 0);
+    assert(summands.min() >= 0 && summands.max() < this->summands());
+
+    (void)summands;
+    return vgrad(x, gx);
+}
+
+void function_t::hvp(const vector_t& x, const vector_t& v, vector_t& hv) const
 {
     assert(x.size() == size());
+    assert(v.size() == size());
+
+    hv.resize(size());
+
+    const auto vnorm = v.lpNorm<Eigen::Infinity>();
+    if (vnorm < std::numeric_limits<scalar_t>::epsilon())
+    {
+        hv.setZero();
+        return;
+    }
+
+    // finite-difference approximated Hessian-vector product
+    //      see "Numerical optimization", Nocedal & Wright, 2nd edition, p.197
+    const auto dx = epsilon3<scalar_t>() * (1 + x.lpNorm<Eigen::Infinity>()) / vnorm;
+
+    vector_t gp(size()), gn(size());
+    vgrad(x + dx * v, &gp);
+    vgrad(x - dx * v, &gn);
+
+    hv = (gp - gn) / (2 * dx);
+}
+
+tensor_size_t function_t::bytes() const
+{
+    return 2 * size() * static_cast<tensor_size_t>(sizeof(scalar_t));
+}
+
+tensor_size_t function_t::hvp_bytes() const
+{
+    return 2 * bytes();
+}
+
+void function_t::vgrads(const matrix_t& X, vector_t& fx, matrix_t* gx) const
+{
+    assert(X.cols() == size());
+
+    fx.resize(X.rows());
+    if (gx != nullptr)
+    {
+        gx->resize(X.rows(), X.cols());
+    }
+
+    vector_t x(size()), g(size());
+    for (tensor_size_t i = 0; i < X.rows(); ++ i)
+    {
+        x = X.row(i).transpose();
+        fx(i) = vgrad(x, (gx != nullptr) ? &g : nullptr);
+        if (gx != nullptr)
+        {
+            gx->row(i) = g.transpose();
+        }
+    }
+}
+
+scalar_t function_t::grad_accuracy(const vector_t& x, const tensor_size_t directions, const execution policy) const
+{
+    assert(x.size() == size());
+    assert(directions >= 0);
 
     const auto n = size();
 
     vector_t gx(n);
-    vector_t gx_approx(n);
-    vector_t xp = x, xn = x;
 
     // analytical gradient
     const auto fx = vgrad(x, &gx);
     assert(gx.size() == size());
 
+    // NB: the (expensive) function evaluations are distributed on the thread pool using per-thread copies of x,
+    //  but only if requested as the function may not be safe to evaluate concurrently.
+    const auto threads = (policy == execution::par) ? tpool_t::size() : size_t{1};
+
+    std::vector<vector_t> xps(threads, x);
+    std::vector<vector_t> xns(threads, x);
+
+    const auto loop = [&] (const tensor_size_t size, const auto& op)
+    {
+        if (policy == execution::par)
+        {
+            loopi(size, op);
+        }
+        else
+        {
+            for (tensor_size_t i = 0; i < size; ++ i)
+            {
+                op(i, size_t{0});
+            }
+        }
+    };
+
     // finite-difference approximated gradient
     //      see "Numerical optimization", Nocedal & Wright, 2nd edition, p.197
-    const auto finite_difference = [&] (const scalar_t dx)
+    const auto dx = epsilon2<scalar_t>();
+    if (directions == 0)
     {
-        for (auto i = 0; i < n; i ++)
+        vector_t gx_approx(n);
+        loop(n, [&] (const tensor_size_t i, const size_t tnum)
         {
-            xp = x; xp(i) += dx * (1 + std::fabs(x(i)));
-            xn = x; xn(i) -= dx * (1 + std::fabs(x(i)));
+            auto& xp = xps[tnum];
+            auto& xn = xns[tnum];
+
+            xp(i) = x(i) + dx * (1 + std::fabs(x(i)));
+            xn(i) = x(i) - dx * (1 + std::fabs(x(i)));
 
             const auto dfi = vgrad(xp, nullptr) - vgrad(xn, nullptr);
             const auto dxi = xp(i) - xn(i);
             gx_approx(i) = dfi / dxi;
 
+            xp(i) = xn(i) = x(i);
+
             assert(std::isfinite(gx(i)));
             assert(std::isfinite(gx_approx(i)));
-        }
+        });
 
         return (gx - gx_approx).lpNorm<Eigen::Infinity>() / (1 + std::fabs(fx));
-    };
+    }
+
+    // finite-difference approximated directional derivatives along random (unit) directions
+    //  (much cheaper for large functions, as the number of directions is independent of the number of dimensions)
+    auto rng = make_rng();
+    matrix_t directs(directions, n);
+    urand(scalar_t(-1), scalar_t(+1), directs.data(), directs.data() + directs.size(), rng);
+    directs.rowwise().normalize();
+
+    const vector_t dg = directs * gx;
+    const auto dt = dx * (1 + x.lpNorm<Eigen::Infinity>());
+
+    vector_t dg_approx(directions);
+    loop(directions, [&] (const tensor_size_t i, const size_t tnum)
+    {
+        auto& xp = xps[tnum];
+        auto& xn = xns[tnum];
+
+        xp = x + dt * directs.row(i).transpose();
+        xn = x - dt * directs.row(i).transpose();
+
+        dg_approx(i) = (vgrad(xp, nullptr) - vgrad(xn, nullptr)) / (2 * dt);
+
+        assert(std::isfinite(dg(i)));
+        assert(std::isfinite(dg_approx(i)));
+    });
 
-    return finite_difference(epsilon2<scalar_t>());
+    return (dg - dg_approx).lpNorm<Eigen::Infinity>() / (1 + std::fabs(fx));
 }
 
 bool function_t::is_convex(const vector_t& x1, const vector_t& x2, const int steps) const
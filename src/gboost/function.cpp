@@ -104,13 +104,19 @@ scalar_t gboost_scale_function_t::vgrad(const vector_t& x, vector_t* gx) const
         }
 
         tensor1d_t values;
-        m_loss.value(targets, outputs, values);
+        tensor4d_t vgrads;
+        if (gx != nullptr)
+        {
+            m_loss.value_vgrad(targets, outputs, values, vgrads);
+        }
+        else
+        {
+            m_loss.value(targets, outputs, values);
+        }
         cache.update(values);
 
         if (gx != nullptr)
         {
-            tensor4d_t vgrads;
-            m_loss.vgrad(targets, outputs, vgrads);
 
             for (tensor_size_t i = begin; i < end; ++ i)
             {
@@ -161,13 +167,19 @@ scalar_t gboost_bias_function_t::vgrad(const vector_t& x, vector_t* gx) const
         outputs.reshape(range.size(), -1).matrix().rowwise() = x.transpose();
 
         tensor1d_t values;
-        m_loss.value(targets, outputs, values);
+        tensor4d_t vgrads;
+        if (gx != nullptr)
+        {
+            m_loss.value_vgrad(targets, outputs, values, vgrads);
+        }
+        else
+        {
+            m_loss.value(targets, outputs, values);
+        }
         cache.update(values);
 
         if (gx != nullptr)
         {
-            tensor4d_t vgrads;
-            m_loss.vgrad(targets, outputs, vgrads);
             const auto gmatrix = vgrads.reshape(range.size(), tsize).matrix();
 
             cache.m_gb1 += gmatrix.colwise().sum();
@@ -218,8 +230,7 @@ const tensor4d_t& gboost_grads_function_t::gradients(const tensor4d_cmap_t& outp
     {
         const auto range = make_range(begin, end);
         const auto targets = m_dataset.targets(m_samples.slice(range));
-        m_loss.value(targets, outputs.slice(range), m_values.slice(range));
-        m_loss.vgrad(targets, outputs.slice(range), m_vgrads.slice(range));
+        m_loss.value_vgrad(targets, outputs.slice(range), m_values.slice(range), m_vgrads.slice(range));
     });
 
     const auto vm1 = m_values.vector().mean();
@@ -2,6 +2,7 @@
 #include <nano/mlearn/util.h>
 #include <nano/gboost/util.h>
 #include <nano/gboost/model.h>
+#include <nano/solver/lbfgsb.h>
 #include <nano/tensor/stream.h>
 #include <nano/dataset/dropcol.h>
 #include <nano/dataset/shuffle.h>
@@ -79,6 +80,13 @@ scalar_t gboost_model_t::fit(
         return errors.mean();
     }
 
+    // NB: the scale factors are constrained to be non-negative,
+    //  so use a bound-constrained solver if the given one doesn't support bounds
+    auto lbfgsb = solver_lbfgsb_t{};
+    lbfgsb.epsilon(solver.epsilon());
+    lbfgsb.max_iterations(solver.max_iterations());
+    const auto& scale_solver = solver.bounded() ? solver : static_cast<const solver_t&>(lbfgsb);
+
     auto grads_function = gboost_grads_function_t{loss, dataset, samples};
     grads_function.vAreg(vAreg());
     grads_function.batch(batch());
@@ -130,10 +138,13 @@ scalar_t gboost_model_t::fit(
         function.vAreg(vAreg());
         function.batch(batch());
 
-        auto state = solver.minimize(function, vector_t::Zero(function.size()));
-        if (state.x.minCoeff() < 0.0)
+        const vector_t lower = vector_t::Zero(function.size());
+        const vector_t upper = vector_t::Constant(function.size(), std::numeric_limits<scalar_t>::infinity());
+
+        auto state = scale_solver.minimize(function, lower, lower, upper);
+        if (state.x.maxCoeff() <= 0.0)
         {
-            log_warning() << "gboost model: invalid scale factor(s): [" << state.x.transpose() << "], stopping.";
+            log_warning() << "gboost model: zero scale factor(s): [" << state.x.transpose() << "], stopping.";
             break;
         }
 
@@ -141,6 +152,11 @@ scalar_t gboost_model_t::fit(
         best_wlearner->scale(state.x);
         scale(cluster, samples, state.x, woutputs);
 
+        // NB: the expected prediction over the training samples is the baseline of the feature contributions
+        tensor1d_t expected(::nano::size(tdim));
+        expected.vector() = woutputs.reshape(samples.size(), -1).matrix().colwise().mean().transpose();
+        best_wlearner->expected(std::move(expected));
+
         // update predictions
         outputs.vector() += woutputs.vector();
         errors = evaluate(dataset, samples, loss, outputs);
@@ -261,22 +277,76 @@ tensor4d_t gboost_model_t::predict(const dataset_t& dataset, const indices_t& sa
         "gboost model: cannot predict without a trained model!");
 
     tensor4d_t outputs(cat_dims(samples.size(), dataset.tdim()));
-    outputs.reshape(samples.size(), -1).matrix().rowwise() = m_bias.vector().transpose();
 
     loopr(samples.size(), batch(), [&] (tensor_size_t begin, tensor_size_t end, size_t)
     {
         const auto range = make_range(begin, end);
-        const auto wsamples = samples.slice(range);
-        const auto woutputs = outputs.slice(range);
-        for (const auto& iwlearner : m_iwlearners)
+        predict(dataset, samples.slice(range), outputs.slice(range));
+    });
+
+    return outputs;
+}
+
+void gboost_model_t::predict(const dataset_t& dataset, const indices_cmap_t& samples, tensor4d_map_t outputs) const
+{
+    critical(
+        m_bias.size() != ::nano::size(dataset.tdim()) &&
+        m_iwlearners.empty(),
+        "gboost model: cannot predict without a trained model!");
+
+    outputs.reshape(samples.size(), -1).matrix().rowwise() = m_bias.vector().transpose();
+    for (const auto& iwlearner : m_iwlearners)
+    {
+        iwlearner.get().predict(dataset, samples, outputs);
+    }
+}
+
+tensor4d_t gboost_model_t::predict_shuffled(const dataset_t& dataset, const dataset_t& shuffled_dataset,
+    const tensor_size_t feature, const indices_t& samples, const tensor4d_t& baseline_outputs) const
+{
+    assert(baseline_outputs.dims() == cat_dims(samples.size(), dataset.tdim()));
+
+    tensor4d_t outputs(baseline_outputs.dims()), woutputs(baseline_outputs.dims());
+    outputs.zero();
+    woutputs.zero();
+    for (const auto& iwlearner : m_iwlearners)
+    {
+        const auto& wlearner = iwlearner.get();
+        const auto wfeatures = wlearner.features();
+        if (std::find(wfeatures.begin(), wfeatures.end(), feature) != wfeatures.end())
         {
-            iwlearner.get().predict(dataset, wsamples, woutputs);
+            wlearner.predict(shuffled_dataset, samples, outputs);
+            wlearner.predict(dataset, samples, woutputs);
         }
-    });
+    }
+    outputs.vector() += baseline_outputs.vector() - woutputs.vector();
 
     return outputs;
 }
 
+tensor3d_t gboost_model_t::contributions(const dataset_t& dataset, const indices_t& samples) const
+{
+    critical(
+        m_bias.size() != ::nano::size(dataset.tdim()) &&
+        m_iwlearners.empty(),
+        "gboost model: cannot estimate feature contributions without a trained model!");
+
+    tensor3d_t contributions(samples.size(), dataset.features() + 1, ::nano::size(dataset.tdim()));
+    contributions.zero();
+
+    loopi(samples.size(), [&] (tensor_size_t i, size_t)
+    {
+        contributions.matrix(i).row(dataset.features()) = m_bias.vector().transpose();
+    });
+
+    for (const auto& iwlearner : m_iwlearners)
+    {
+        iwlearner.get().contributions(dataset, samples, contributions);
+    }
+
+    return contributions;
+}
+
 void gboost_model_t::read(std::istream& stream)
 {
     model_t::read(stream);
@@ -339,23 +409,51 @@ feature_infos_t gboost_model_t::features(
     };
 
     // baseline error rate
-    const auto baseline_error = evaluate(*this, dataset);
+    const auto baseline_outputs = predict(dataset, samples);
+    loss.error(targets, baseline_outputs, errors);
+    const auto baseline_error = errors.mean();
     log_info() << std::fixed << std::setprecision(6)
         << "gboost model: baseline error=" << baseline_error << ".";
 
+    // estimate the impact of shuffling each feature at a time on the error rate:
+    //  - the (feature, trial) pairs are evaluated in parallel,
+    //  - each trial uses a fixed permutation of the samples and
+    //  - only the weak learners using the shuffled feature are evaluated to update the baseline outputs.
+    tensor2d_t shuffle_errors;
+    if (type == importance::shuffle)
+    {
+        shuffle_errors.resize(static_cast<tensor_size_t>(infos.size()), trials);
+        loopi(shuffle_errors.size(), [&] (tensor_size_t index, size_t)
+        {
+            const auto& info = infos[static_cast<size_t>(index / trials)];
+            const auto feature = info.feature();
+
+            auto permutation = arange(0, dataset.samples());
+            auto shuffled = samples;
+            std::shuffle(shuffled.begin(), shuffled.end(), make_rng());
+            for (tensor_size_t i = 0; i < samples.size(); ++ i)
+            {
+                permutation(samples(i)) = shuffled(i);
+            }
+            const auto fdataset = shuffle_dataset_t{dataset, feature, std::move(permutation)};
+            const auto outputs = predict_shuffled(dataset, fdataset, feature, samples, baseline_outputs);
+
+            tensor1d_t ferrors(samples.size());
+            loss.error(targets, outputs, ferrors);
+            shuffle_errors(index / trials, index % trials) = ferrors.mean();
+        });
+    }
+
     // estimate the importance of EACH of the selected features
-    for (auto& info : infos)
+    for (size_t ifeature = 0; ifeature < infos.size(); ++ ifeature)
     {
+        auto& info = infos[ifeature];
         scalar_t feature_error = 0.0;
 
         switch (type)
         {
-        case importance::shuffle:   // estimate the impact of shuffling each feature at a time on the error rate
-            for (tensor_size_t trial = 0; trial < trials; ++ trial)
-            {
-                const auto fdataset = shuffle_dataset_t{dataset, info.feature()};
-                feature_error += evaluate(*this, fdataset) / trials;
-            }
+        case importance::shuffle:
+            feature_error = shuffle_errors.vector(static_cast<tensor_size_t>(ifeature)).mean();
             break;
 
         case importance::dropcol:   // estimate the impact of removing each feature at a time on the error rate
@@ -1,4 +1,5 @@
 #include <mutex>
+#include <nano/tpool.h>
 #include <nano/logger.h>
 #include <nano/tensor/stream.h>
 #include <nano/gboost/wlearner_dstep.h>
@@ -15,6 +16,11 @@ void wlearner_t::batch(int batch)
     m_batch = batch;
 }
 
+void wlearner_t::expected(tensor1d_t expected)
+{
+    m_expected = std::move(expected);
+}
+
 void wlearner_t::read(std::istream& stream)
 {
     serializable_t::read(stream);
@@ -25,6 +31,16 @@ void wlearner_t::read(std::istream& stream)
         !::nano::read(stream, ibatch),
         "weak learner: failed to read from stream!");
 
+    // NB: the expected prediction is serialized starting with version 1.0.1,
+    //  otherwise it is left empty and the feature contributions cannot be computed.
+    m_expected = tensor1d_t{};
+    if (serialized_since(1, 0, 1))
+    {
+        critical(
+            !::nano::read(stream, m_expected),
+            "weak learner: failed to read from stream!");
+    }
+
     batch(ibatch);
 }
 
@@ -33,7 +49,8 @@ void wlearner_t::write(std::ostream& stream) const
     serializable_t::write(stream);
 
     critical(
-        !::nano::write(stream, static_cast<int32_t>(batch())),
+        !::nano::write(stream, static_cast<int32_t>(batch())) ||
+        !::nano::write(stream, m_expected),
         "weak learner: failed to write to stream!");
 }
 
@@ -69,6 +86,46 @@ tensor4d_t wlearner_t::predict(const dataset_t& dataset, const indices_cmap_t& s
     return outputs;
 }
 
+void wlearner_t::contributions(const dataset_t& dataset, const indices_t& samples, tensor3d_map_t contributions) const
+{
+    const auto features = this->features();
+
+    critical(
+        features.size() != 1,
+        "weak learner: feature contributions are only supported for single-feature weak learners!");
+
+    critical(
+        contributions.dims() != make_dims(samples.size(), dataset.features() + 1, ::nano::size(dataset.tdim())),
+        "weak learner: mis-matching feature contributions!");
+
+    critical(
+        m_expected.size() != ::nano::size(dataset.tdim()),
+        "weak learner: the expected prediction over the training samples is not set!");
+
+    if (samples.size() == 0)
+    {
+        return;
+    }
+
+    tensor4d_t outputs(cat_dims(samples.size(), dataset.tdim()));
+    outputs.zero();
+    loopr(samples.size(), batch(), [&] (tensor_size_t begin, tensor_size_t end, size_t)
+    {
+        const auto range = make_range(begin, end);
+        predict(dataset, samples.slice(range), outputs.slice(range));
+    });
+
+    // NB: the contribution of the feature is the deviation from the expected prediction
+    const auto omatrix = outputs.reshape(samples.size(), -1).matrix();
+    const auto expected = m_expected.vector();
+    loopi(samples.size(), [&] (tensor_size_t i, size_t)
+    {
+        auto cmatrix = contributions.matrix(i);
+        cmatrix.row(features(0)) += omatrix.row(i) - expected.transpose();
+        cmatrix.row(dataset.features()) += expected.transpose();
+    });
+}
+
 wlearner_factory_t& wlearner_t::all()
 {
     static wlearner_factory_t manager;
@@ -54,6 +54,87 @@ namespace
         tensor_size_t   m_feature{0};                           ///<
         scalar_t        m_score{wlearner_t::no_fit_score()};    ///<
     };
+
+    ///
+    /// \brief sufficient statistics (x0, x1, x2, r1, rx, r2) for all the given features,
+    ///     accumulated over blocks of samples as matrix products:
+    ///         r1 = -M^T * G, rx = -F^T * G, r2 = M^T * G^2,
+    ///
+    ///     where G is the (samples, #outputs) matrix of gradients, F is the (samples, #features) matrix
+    ///     of transformed feature values (zero if missing) and M is the associated mask of given feature values.
+    ///
+    class stats_t
+    {
+    public:
+
+        stats_t() = default;
+
+        stats_t(tensor_size_t features, tensor_size_t outputs) :
+            m_x0(vector_t::Zero(features)),
+            m_x1(vector_t::Zero(features)),
+            m_x2(vector_t::Zero(features)),
+            m_r1(matrix_t::Zero(features, outputs)),
+            m_rx(matrix_t::Zero(features, outputs)),
+            m_r2(matrix_t::Zero(features, outputs))
+        {
+        }
+
+        template <typename tfun1>
+        void update(const tensor2d_t& fvalues, const indices_cmap_t& samples, const tensor4d_t& gradients)
+        {
+            m_f.resize(fvalues.rows(), fvalues.cols());
+            m_m.resize(fvalues.rows(), fvalues.cols());
+            m_g.resize(samples.size(), m_r1.cols());
+
+            for (tensor_size_t i = 0; i < samples.size(); ++ i)
+            {
+                for (tensor_size_t f = 0; f < fvalues.cols(); ++ f)
+                {
+                    const auto value = fvalues(i, f);
+                    const auto given = !feature_t::missing(value);
+
+                    m_m(i, f) = given ? 1.0 : 0.0;
+                    m_f(i, f) = given ? tfun1::get(value) : 0.0;
+                }
+                m_g.row(i) = gradients.vector(samples(i)).transpose();
+            }
+
+            m_x0 += m_m.colwise().sum().transpose();
+            m_x1 += m_f.colwise().sum().transpose();
+            m_x2 += m_f.array().square().colwise().sum().matrix().transpose();
+            m_r1.noalias() -= m_m.transpose() * m_g;
+            m_rx.noalias() -= m_f.transpose() * m_g;
+            m_r2.noalias() += m_m.transpose() * m_g.array().square().matrix();
+        }
+
+        stats_t& operator+=(const stats_t& other)
+        {
+            m_x0 += other.m_x0;
+            m_x1 += other.m_x1;
+            m_x2 += other.m_x2;
+            m_r1 += other.m_r1;
+            m_rx += other.m_rx;
+            m_r2 += other.m_r2;
+            return *this;
+        }
+
+        void get(tensor_size_t feature, accumulator_t& acc) const
+        {
+            acc.x0() = m_x0(feature);
+            acc.x1() = m_x1(feature);
+            acc.x2() = m_x2(feature);
+            acc.r1() = m_r1.row(feature).transpose().array();
+            acc.rx() = m_rx.row(feature).transpose().array();
+            acc.r2() = m_r2.row(feature).transpose().array();
+        }
+
+    private:
+
+        // attributes
+        vector_t        m_x0, m_x1, m_x2;       ///< (#features)
+        matrix_t        m_r1, m_rx, m_r2;       ///< (#features, #outputs)
+        matrix_t        m_f, m_m, m_g;          ///< buffers: block of samples
+    };
 }
 
 template <typename tfun1>
@@ -72,35 +153,51 @@ scalar_t wlearner_affine_t<tfun1>::fit(const dataset_t& dataset, const indices_t
     assert(samples.max() < dataset.samples());
     assert(gradients.dims() == cat_dims(dataset.samples(), dataset.tdim()));
 
-    std::vector<cache_t> caches(tpool_t::size(), cache_t{dataset.tdim()});
-    wlearner_feature1_t::loopc(dataset, samples,
-        [&] (tensor_size_t feature, const tensor1d_t& fvalues, size_t tnum)
+    // select the continuous features
+    std::vector<tensor_size_t> cfeatures;
+    for (tensor_size_t feature = 0; feature < dataset.features(); ++ feature)
     {
-        // update accumulators
-        auto& cache = caches[tnum];
-        cache.clear();
-        for (tensor_size_t i = 0; i < samples.size(); ++ i)
+        if (!dataset.feature(feature).discrete())
         {
-            const auto value = fvalues(i);
-            if (!feature_t::missing(value))
-            {
-                cache.m_acc.update(tfun1::get(value), gradients.array(samples(i)));
-            }
+            cfeatures.push_back(feature);
         }
+    }
+    const indices_t features = map_tensor(cfeatures.data(), static_cast<tensor_size_t>(cfeatures.size()));
+
+    // accumulate the sufficient statistics for all features at once in blocks of samples
+    static constexpr tensor_size_t block_size = 1024;
+
+    const auto outputs = ::nano::size(dataset.tdim());
+    std::vector<stats_t> stats(tpool_t::size(), stats_t{features.size(), outputs});
+    if (features.size() > 0)
+    {
+        loopr(samples.size(), block_size, [&] (tensor_size_t begin, tensor_size_t end, size_t tnum)
+        {
+            const auto bsamples = samples.slice(begin, end);
+            stats[tnum].update<tfun1>(dataset.inputs(bsamples, features), bsamples, gradients);
+        });
+    }
+    for (size_t t = 1; t < stats.size(); ++ t)
+    {
+        stats[0] += stats[t];
+    }
+
+    // OK, select the optimum feature
+    cache_t cache{dataset.tdim()}, best{dataset.tdim()};
+    for (tensor_size_t f = 0; f < features.size(); ++ f)
+    {
+        stats[0].get(f, cache.m_acc);
 
         // update the parameters if a better feature
         const auto score = cache.score();
-        if (std::isfinite(score) && score < cache.m_score)
+        if (std::isfinite(score) && score < best.m_score)
         {
-            cache.m_score = score;
-            cache.m_feature = feature;
-            cache.m_tables.array(0) = cache.a();
-            cache.m_tables.array(1) = cache.b();
+            best.m_score = score;
+            best.m_feature = features(f);
+            best.m_tables.array(0) = cache.a();
+            best.m_tables.array(1) = cache.b();
         }
-    });
-
-    // OK, return and store the optimum feature across threads
-    const auto& best = ::nano::gboost::min_reduce(caches);
+    }
 
     log_info() << std::fixed << std::setprecision(8) << " === affine(feature=" << best.m_feature << "|"
         << (best.m_feature >= 0 ? dataset.feature(best.m_feature).name() : string_t("N/A"))
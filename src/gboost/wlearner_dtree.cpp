@@ -78,18 +78,44 @@ namespace
         return stream;
     }
 
-    void append(tensor4d_t& tables, const tensor3d_cmap_t& table)
+    ///
+    /// \brief buffer of tables at the leaves with geometrically increasing capacity,
+    ///     so that appending a new table is amortized constant time.
+    ///
+    class tables_t
     {
-        // NB: This conservative resize is not very efficient!
-        const auto copy = tables;
-        const auto count = tables.size<0>();
-        tables.resize(cat_dims(count + 1, table.dims()));
-        if (count > 0)
+    public:
+
+        explicit tables_t(const tensor3d_dim_t& tdim) :
+            m_tables(cat_dims(0, tdim))
         {
-            tables.slice(0, count) = copy;
         }
-        tables.tensor(count) = table;
-    }
+
+        tensor_size_t append(const tensor3d_cmap_t& table)
+        {
+            if (m_size == m_tables.size<0>())
+            {
+                tensor4d_t tables(cat_dims(std::max(m_size * 2, tensor_size_t(16)), table.dims()));
+                // NB: copy the values explicitly, as assigning the (temporary) tensor maps would only rebind them!
+                tables.slice(0, m_size).vector() = m_tables.slice(0, m_size).vector();
+                m_tables = std::move(tables);
+            }
+
+            m_tables.tensor(m_size) = table;
+            return m_size ++;
+        }
+
+        tensor4d_t shrink_to_fit() const
+        {
+            return m_tables.slice(0, m_size);
+        }
+
+    private:
+
+        // attributes
+        tensor4d_t      m_tables;       ///< (capacity, #outputs)
+        tensor_size_t   m_size{0};      ///< number of tables appended so far
+    };
 
     void update(dtree_nodes_t& nodes, indices_t& features)
     {
@@ -190,6 +216,216 @@ namespace
             }
         }
     }
+    size_t branch(const dtree_node_t& node, scalar_t x)
+    {
+        if (node.m_classes > 0)
+        {
+            const auto iclass = static_cast<tensor_size_t>(x);
+            critical(
+                iclass < 0 || iclass >= node.m_classes,
+                "dtree weak learner: out-of-range discrete feature!");
+
+            return static_cast<size_t>(iclass);
+        }
+        else
+        {
+            return static_cast<size_t>(x < node.m_threshold ? 0U : 1U);
+        }
+    }
+
+    size_t depth(const dtree_nodes_t& nodes, size_t inode = 0U)
+    {
+        // NB: maximum number of splits from the given split to a leaf
+        size_t depth = 0;
+        const auto children = static_cast<size_t>(nodes[inode].m_classes > 0 ? nodes[inode].m_classes : 2);
+        for (auto child = inode; child < inode + children; ++ child)
+        {
+            const auto next = nodes[child].m_next;
+            if (next > inode)
+            {
+                depth = std::max(depth, ::depth(nodes, next));
+            }
+        }
+        return depth + 1;
+    }
+
+    struct path_element_t
+    {
+        tensor_size_t   m_feature{-1};
+        scalar_t        m_zero_fraction{0};
+        scalar_t        m_one_fraction{0};
+        scalar_t        m_pweight{0};
+    };
+
+    ///
+    /// \brief path-dependent TreeSHAP algorithm (see Algorithm 2) to compute the exact SHAP values of a decision tree,
+    ///     see "Consistent Individualized Feature Attribution for Tree Ensembles", by S. Lundberg, G. Erion, S.-I. Lee.
+    ///
+    /// NB: the multi-way splits (discrete features) are handled by recursing into every child
+    ///     and the missing feature values are handled as an additional (implicit) leaf predicting zero.
+    ///
+    class treeshap_t
+    {
+    public:
+
+        treeshap_t(const dtree_nodes_t& nodes, const tensor4d_t& tables, const indices_t& features, const tensor2d_t& covers) :
+            m_nodes(nodes),
+            m_tables(tables),
+            m_features(features),
+            m_covers(covers),
+            m_path((::depth(nodes) + 3) * (::depth(nodes) + 4) / 2)
+        {
+        }
+
+        template <typename tmatrix>
+        void operator()(const tensor1d_cmap_t& fvalues, tmatrix&& phi)
+        {
+            recurse(fvalues, phi, m_path.data(), 0U, 0U, false, 1.0, 1.0, -1);
+        }
+
+    private:
+
+        template <typename tmatrix>
+        void recurse(const tensor1d_cmap_t& fvalues, tmatrix& phi, path_element_t* parent_path, size_t depth,
+            size_t inode, bool leaf, scalar_t zero_fraction, scalar_t one_fraction, tensor_size_t feature)
+        {
+            auto* const path = parent_path + depth + 1;
+            std::copy(parent_path, parent_path + depth + 1, path);
+            extend(path, depth, zero_fraction, one_fraction, feature);
+
+            // leaf: update the contributions of the features on the path
+            if (leaf)
+            {
+                const auto table = m_nodes[inode].m_table;
+                if (table >= 0)
+                {
+                    const auto value = m_tables.vector(table);
+                    for (size_t i = 1; i <= depth; ++ i)
+                    {
+                        const auto& elem = path[i];
+                        const auto weight = unwound_sum(path, depth, i);
+                        phi.row(m_features(elem.m_feature)) +=
+                            weight * (elem.m_one_fraction - elem.m_zero_fraction) * value.transpose();
+                    }
+                }
+                return;
+            }
+
+            // split: undo the previous split on the same feature (if any) ...
+            const auto& node = m_nodes[inode];
+            const auto x = fvalues(node.m_feature);
+
+            auto izero_fraction = 1.0;
+            auto ione_fraction = 1.0;
+            for (size_t i = 1; i <= depth; ++ i)
+            {
+                if (path[i].m_feature == node.m_feature)
+                {
+                    izero_fraction = path[i].m_zero_fraction;
+                    ione_fraction = path[i].m_one_fraction;
+                    unwind(path, depth, i);
+                    -- depth;
+                    break;
+                }
+            }
+
+            // ... and recurse into the children weighted by their covers
+            const auto hot = feature_t::missing(x) ? m_nodes.size() : inode + branch(node, x);
+            const auto children = static_cast<size_t>(node.m_classes > 0 ? node.m_classes : 2);
+            for (auto child = inode; child < inode + children; ++ child)
+            {
+                const auto czero_fraction = izero_fraction *
+                    m_covers(0, static_cast<tensor_size_t>(child)) /
+                    m_covers(1, static_cast<tensor_size_t>(inode));
+                const auto cone_fraction = (child == hot) ? ione_fraction : 0.0;
+                if (czero_fraction <= 0.0 && cone_fraction <= 0.0)
+                {
+                    continue;
+                }
+
+                const auto next = m_nodes[child].m_next;
+                const auto cleaf = next <= inode;
+                recurse(fvalues, phi, path, depth + 1, cleaf ? child : next, cleaf,
+                    czero_fraction, cone_fraction, node.m_feature);
+            }
+        }
+
+        static void extend(path_element_t* path, size_t depth,
+            scalar_t zero_fraction, scalar_t one_fraction, tensor_size_t feature)
+        {
+            const auto d = static_cast<scalar_t>(depth);
+
+            path[depth] = {feature, zero_fraction, one_fraction, depth == 0 ? 1.0 : 0.0};
+            for (size_t i = depth; i-- > 0; )
+            {
+                const auto s = static_cast<scalar_t>(i);
+                path[i + 1].m_pweight += one_fraction * path[i].m_pweight * (s + 1) / (d + 1);
+                path[i].m_pweight = zero_fraction * path[i].m_pweight * (d - s) / (d + 1);
+            }
+        }
+
+        static void unwind(path_element_t* path, size_t depth, size_t index)
+        {
+            const auto d = static_cast<scalar_t>(depth);
+            const auto one_fraction = path[index].m_one_fraction;
+            const auto zero_fraction = path[index].m_zero_fraction;
+
+            auto next = path[depth].m_pweight;
+            for (size_t i = depth; i-- > 0; )
+            {
+                const auto s = static_cast<scalar_t>(i);
+                if (one_fraction > 0.0)
+                {
+                    const auto pweight = path[i].m_pweight;
+                    path[i].m_pweight = next * (d + 1) / ((s + 1) * one_fraction);
+                    next = pweight - path[i].m_pweight * zero_fraction * (d - s) / (d + 1);
+                }
+                else
+                {
+                    path[i].m_pweight = path[i].m_pweight * (d + 1) / (zero_fraction * (d - s));
+                }
+            }
+
+            for (auto i = index; i < depth; ++ i)
+            {
+                path[i].m_feature = path[i + 1].m_feature;
+                path[i].m_zero_fraction = path[i + 1].m_zero_fraction;
+                path[i].m_one_fraction = path[i + 1].m_one_fraction;
+            }
+        }
+
+        static scalar_t unwound_sum(const path_element_t* path, size_t depth, size_t index)
+        {
+            const auto d = static_cast<scalar_t>(depth);
+            const auto one_fraction = path[index].m_one_fraction;
+            const auto zero_fraction = path[index].m_zero_fraction;
+
+            auto next = path[depth].m_pweight;
+            auto total = 0.0;
+            for (size_t i = depth; i-- > 0; )
+            {
+                const auto s = static_cast<scalar_t>(i);
+                if (one_fraction > 0.0)
+                {
+                    const auto weight = next / ((s + 1) * one_fraction);
+                    total += weight;
+                    next = path[i].m_pweight - weight * zero_fraction * (d - s);
+                }
+                else
+                {
+                    total += path[i].m_pweight / (zero_fraction * (d - s));
+                }
+            }
+            return total * (d + 1);
+        }
+
+        // attributes
+        const dtree_nodes_t&        m_nodes;        ///<
+        const tensor4d_t&           m_tables;       ///<
+        const indices_t&            m_features;     ///<
+        const tensor2d_t&           m_covers;       ///< number of training samples reaching each node and split
+        std::vector<path_element_t> m_path;         ///< buffer to store the paths from the root to the current node
+    };
 }
 
 wlearner_dtree_t::wlearner_dtree_t() = default;
@@ -218,6 +454,16 @@ void wlearner_dtree_t::read(std::istream& stream)
         !::nano::read(stream, m_tables),
         "dtree weak learner: failed to read from stream!");
 
+    // NB: the node covers are serialized starting with version 1.0.1,
+    //  otherwise they are left empty and the feature contributions cannot be computed.
+    m_covers = tensor2d_t{};
+    if (serialized_since(1, 0, 1))
+    {
+        critical(
+            !::nano::read(stream, m_covers),
+            "dtree weak learner: failed to read from stream!");
+    }
+
     max_depth(idepth);
     min_split(isplit);
 }
@@ -230,7 +476,8 @@ void wlearner_dtree_t::write(std::ostream& stream) const
         !::nano::write(stream, static_cast<int32_t>(min_split())) ||
         !::write(stream, m_nodes) ||
         !::write(stream, m_features) ||
-        !::nano::write(stream, m_tables),
+        !::nano::write(stream, m_tables) ||
+        !::nano::write(stream, m_covers),
         "dtree weak learner: failed to write to stream!");
 }
 
@@ -253,7 +500,10 @@ scalar_t wlearner_dtree_t::fit(const dataset_t& dataset, const indices_t& sample
     scalar_t score = 0;
 
     m_nodes.clear();
-    m_tables.resize(cat_dims(0, dataset.tdim()));
+    auto tables_buffer = tables_t{dataset.tdim()};
+
+    // NB: number of training samples reaching each node and each split (indexed by its first node)
+    std::vector<scalar_t> node_covers, split_covers;
 
     auto stump = wlearner_stump_t{};
     auto table = wlearner_table_t{};
@@ -273,6 +523,29 @@ scalar_t wlearner_dtree_t::fit(const dataset_t& dataset, const indices_t& sample
         const auto score_stump = stump.fit(dataset, cache.m_samples, gradients);
         const auto score_table = table.fit(dataset, cache.m_samples, gradients);
 
+        // cannot split the samples (e.g. too few), so have the parent node be a terminal node
+        if (score_stump == wlearner_t::no_fit_score() && score_table == wlearner_t::no_fit_score())
+        {
+            if (m_nodes.empty())
+            {
+                m_tables.resize(cat_dims(0, dataset.tdim()));
+                m_features.resize(0);
+                m_covers.resize(2, 0);
+                return wlearner_t::no_fit_score();
+            }
+
+            m_nodes[cache.m_parent].m_table = tables_buffer.append(cache.m_table);
+
+            // also, update the total score with the residuals of the samples reaching this terminal node
+            for (const auto sample : cache.m_samples)
+            {
+                score += (gradients.array(sample) + cache.m_table.array()).square().sum();
+            }
+
+            caches.pop_front();
+            continue;
+        }
+
         cluster_t cluster;
         tensor4d_t tables;
         dtree_node_t node;
@@ -312,9 +585,10 @@ scalar_t wlearner_dtree_t::fit(const dataset_t& dataset, const indices_t& sample
                 ncache.m_parent = m_nodes.size();
                 ncache.m_samples = cluster.indices(i);
 
-                node.m_table = m_tables.size<0>();
+                node.m_table = tables_buffer.append(tables.tensor(i));
                 m_nodes.emplace_back(node);
-                append(m_tables, tables.tensor(i));
+                node_covers.push_back(static_cast<scalar_t>(ncache.m_samples.size()));
+                split_covers.push_back(i == 0 ? static_cast<scalar_t>(cache.m_samples.size()) : 0.0);
             }
 
             // also, update the total score
@@ -328,9 +602,12 @@ scalar_t wlearner_dtree_t::fit(const dataset_t& dataset, const indices_t& sample
             {
                 ncache.m_parent = m_nodes.size();
                 ncache.m_samples = cluster.indices(i);
+                ncache.m_table = tables.tensor(i);
 
                 node.m_table = -1;
                 m_nodes.push_back(node);
+                node_covers.push_back(static_cast<scalar_t>(ncache.m_samples.size()));
+                split_covers.push_back(i == 0 ? static_cast<scalar_t>(cache.m_samples.size()) : 0.0);
                 caches.push_back(ncache);
             }
         }
@@ -338,8 +615,16 @@ scalar_t wlearner_dtree_t::fit(const dataset_t& dataset, const indices_t& sample
         caches.pop_front();
     }
 
-    // OK, compact the selected features
+    // OK, compact the selected features and the tables at the leaves
     ::update(m_nodes, m_features);
+    m_tables = tables_buffer.shrink_to_fit();
+
+    m_covers.resize(2, static_cast<tensor_size_t>(m_nodes.size()));
+    for (size_t inode = 0; inode < m_nodes.size(); ++ inode)
+    {
+        m_covers(0, static_cast<tensor_size_t>(inode)) = node_covers[inode];
+        m_covers(1, static_cast<tensor_size_t>(inode)) = split_covers[inode];
+    }
 
     log_info() << std::fixed << std::setprecision(8) << " === tree(features="
         << m_features.size() << ",nodes=" << m_nodes.size() << "), score=" << score << ".";
@@ -399,6 +684,50 @@ void wlearner_dtree_t::predict(const dataset_t& dataset, const indices_cmap_t& s
     }
 }
 
+void wlearner_dtree_t::contributions(const dataset_t& dataset, const indices_t& samples, tensor3d_map_t contributions) const
+{
+    compatible(dataset);
+
+    critical(
+        contributions.dims() != make_dims(samples.size(), dataset.features() + 1, ::nano::size(dataset.tdim())),
+        "dtree weak learner: mis-matching feature contributions!");
+
+    if (samples.size() == 0)
+    {
+        return;
+    }
+
+    critical(
+        m_covers.dims() != make_dims(2, static_cast<tensor_size_t>(m_nodes.size())),
+        "dtree weak learner: the node covers over the training samples are not set!");
+
+    // NB: the expected prediction is estimated from the training samples reaching each leaf
+    vector_t expected = vector_t::Zero(m_tables.size() / m_tables.size<0>());
+    for (size_t inode = 0; inode < m_nodes.size(); ++ inode)
+    {
+        const auto table = m_nodes[inode].m_table;
+        if (table >= 0)
+        {
+            expected += m_covers(0, static_cast<tensor_size_t>(inode)) * m_tables.vector(table);
+        }
+    }
+    expected /= m_covers(1, 0);
+
+    // compute the contributions of the selected features per sample
+    loopr(samples.size(), batch(), [&] (tensor_size_t begin, tensor_size_t end, size_t)
+    {
+        auto treeshap = treeshap_t{m_nodes, m_tables, m_features, m_covers};
+
+        const auto fvalues = dataset.inputs(samples.slice(make_range(begin, end)), m_features);
+        for (tensor_size_t i = begin; i < end; ++ i)
+        {
+            auto cmatrix = contributions.matrix(i);
+            treeshap(fvalues.tensor(i - begin), cmatrix);
+            cmatrix.row(dataset.features()) += expected.transpose();
+        }
+    });
+}
+
 cluster_t wlearner_dtree_t::split(const dataset_t& dataset, const indices_t& samples) const
 {
     compatible(dataset);
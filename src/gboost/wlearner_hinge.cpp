@@ -42,6 +42,7 @@ namespace
         {
             m_acc_sum.clear();
             m_acc_neg.clear();
+            m_acc_sum.update(values, samples, gradients, [] (scalar_t value) { return value; });
 
             m_ivalues.clear();
             m_ivalues.reserve(values.size());
@@ -50,7 +51,6 @@ namespace
                 if (!feature_t::missing(values(i)))
                 {
                     m_ivalues.emplace_back(values(i), samples(i));
-                    m_acc_sum.update(values(i), gradients.array(samples(i)));
                 }
             }
             std::sort(m_ivalues.begin(), m_ivalues.end());
@@ -153,43 +153,46 @@ scalar_t wlearner_hinge_t::fit(const dataset_t& dataset, const indices_t& sample
         // update accumulators
         auto& cache = caches[tnum];
         cache.clear(gradients, fvalues, samples);
-        for (size_t iv = 0, sv = cache.m_ivalues.size(); iv + 1 < sv; ++ iv)
+        ::nano::gboost::dispatch(size(dataset.tdim()), [&] (auto tsize)
         {
-            const auto& ivalue1 = cache.m_ivalues[iv + 0];
-            const auto& ivalue2 = cache.m_ivalues[iv + 1];
-
-            cache.m_acc_neg.update(ivalue1.first, gradients.array(ivalue1.second));
-
-            if (ivalue1.first < ivalue2.first)
+            for (size_t iv = 0, sv = cache.m_ivalues.size(); iv + 1 < sv; ++ iv)
             {
-                // update the parameters if a better feature
-                const auto threshold = 0.5 * (ivalue1.first + ivalue2.first);
+                const auto& ivalue1 = cache.m_ivalues[iv + 0];
+                const auto& ivalue2 = cache.m_ivalues[iv + 1];
 
-                // ... try the left hinge
-                const auto score_neg = cache.score_neg(threshold);
-                if (std::isfinite(score_neg) && score_neg < cache.m_score)
-                {
-                    cache.m_score = score_neg;
-                    cache.m_feature = feature;
-                    cache.m_hinge = hinge::left;
-                    cache.m_threshold = threshold;
-                    cache.m_tables.array(0) = cache.beta_neg(threshold);
-                    cache.m_tables.array(1) = -threshold * cache.m_tables.array(0);
-                }
+                cache.m_acc_neg.update<tsize>(ivalue1.first, gradients.vector(ivalue1.second).data());
 
-                // ... try the right hinge
-                const auto score_pos = cache.score_pos(threshold);
-                if (std::isfinite(score_pos) && score_pos < cache.m_score)
+                if (ivalue1.first < ivalue2.first)
                 {
-                    cache.m_score = score_pos;
-                    cache.m_feature = feature;
-                    cache.m_hinge = hinge::right;
-                    cache.m_threshold = threshold;
-                    cache.m_tables.array(0) = cache.beta_pos(threshold);
-                    cache.m_tables.array(1) = -threshold * cache.m_tables.array(0);
+                    // update the parameters if a better feature
+                    const auto threshold = 0.5 * (ivalue1.first + ivalue2.first);
+
+                    // ... try the left hinge
+                    const auto score_neg = cache.score_neg(threshold);
+                    if (std::isfinite(score_neg) && score_neg < cache.m_score)
+                    {
+                        cache.m_score = score_neg;
+                        cache.m_feature = feature;
+                        cache.m_hinge = hinge::left;
+                        cache.m_threshold = threshold;
+                        cache.m_tables.array(0) = cache.beta_neg(threshold);
+                        cache.m_tables.array(1) = -threshold * cache.m_tables.array(0);
+                    }
+
+                    // ... try the right hinge
+                    const auto score_pos = cache.score_pos(threshold);
+                    if (std::isfinite(score_pos) && score_pos < cache.m_score)
+                    {
+                        cache.m_score = score_pos;
+                        cache.m_feature = feature;
+                        cache.m_hinge = hinge::right;
+                        cache.m_threshold = threshold;
+                        cache.m_tables.array(0) = cache.beta_pos(threshold);
+                        cache.m_tables.array(1) = -threshold * cache.m_tables.array(0);
+                    }
                 }
             }
-        }
+        });
     });
 
     // OK, return and store the optimum feature across threads
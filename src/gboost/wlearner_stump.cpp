@@ -34,6 +34,7 @@ namespace
         {
             m_acc_sum.clear();
             m_acc_neg.clear();
+            m_acc_sum.update(values, samples, gradients);
 
             m_ivalues.clear();
             m_ivalues.reserve(values.size());
@@ -42,7 +43,6 @@ namespace
                 if (!feature_t::missing(values(i)))
                 {
                     m_ivalues.emplace_back(values(i), samples(i));
-                    m_acc_sum.update(gradients.array(samples(i)));
                 }
             }
             std::sort(m_ivalues.begin(), m_ivalues.end());
@@ -120,27 +120,30 @@ scalar_t wlearner_stump_t::fit(const dataset_t& dataset, const indices_t& sample
         // update accumulators
         auto& cache = caches[tnum];
         cache.clear(gradients, fvalues, samples);
-        for (size_t iv = 0, sv = cache.m_ivalues.size(); iv + 1 < sv; ++ iv)
+        ::nano::gboost::dispatch(size(dataset.tdim()), [&] (auto tsize)
         {
-            const auto& ivalue1 = cache.m_ivalues[iv + 0];
-            const auto& ivalue2 = cache.m_ivalues[iv + 1];
+            for (size_t iv = 0, sv = cache.m_ivalues.size(); iv + 1 < sv; ++ iv)
+            {
+                const auto& ivalue1 = cache.m_ivalues[iv + 0];
+                const auto& ivalue2 = cache.m_ivalues[iv + 1];
 
-            cache.m_acc_neg.update(gradients.array(ivalue1.second));
+                cache.m_acc_neg.update<tsize>(gradients.vector(ivalue1.second).data());
 
-            if (ivalue1.first < ivalue2.first)
-            {
-                // update the parameters if a better feature
-                const auto score = cache.score();
-                if (std::isfinite(score) && score < cache.m_score)
+                if (ivalue1.first < ivalue2.first)
                 {
-                    cache.m_score = score;
-                    cache.m_feature = feature;
-                    cache.m_threshold = 0.5 * (ivalue1.first + ivalue2.first);
-                    cache.m_tables.array(0) = cache.output_neg();
-                    cache.m_tables.array(1) = cache.output_pos();
+                    // update the parameters if a better feature
+                    const auto score = cache.score();
+                    if (std::isfinite(score) && score < cache.m_score)
+                    {
+                        cache.m_score = score;
+                        cache.m_feature = feature;
+                        cache.m_threshold = 0.5 * (ivalue1.first + ivalue2.first);
+                        cache.m_tables.array(0) = cache.output_neg();
+                        cache.m_tables.array(1) = cache.output_pos();
+                    }
                 }
             }
-        }
+        });
     });
 
     // OK, return and store the optimum feature across threads
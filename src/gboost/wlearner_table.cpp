@@ -82,20 +82,23 @@ scalar_t wlearner_table_t::fit(const dataset_t& dataset, const indices_t& sample
         // update accumulators
         auto& cache = caches[tnum];
         cache.clear(n_fvalues);
-        for (tensor_size_t i = 0; i < fvalues.size(); ++ i)
+        ::nano::gboost::dispatch(size(dataset.tdim()), [&] (auto tsize)
         {
-            const auto value = fvalues(i);
-            if (feature_t::missing(value))
+            for (tensor_size_t i = 0; i < fvalues.size(); ++ i)
             {
-                continue;
-            }
+                const auto value = fvalues(i);
+                if (feature_t::missing(value))
+                {
+                    continue;
+                }
 
-            const auto fv = static_cast<tensor_size_t>(value);
-            critical(fv < 0 || fv >= n_fvalues,
-                scat("table weak learner: invalid feature value ", fv, ", expecting [0, ", n_fvalues, ")"));
+                const auto fv = static_cast<tensor_size_t>(value);
+                critical(fv < 0 || fv >= n_fvalues,
+                    scat("table weak learner: invalid feature value ", fv, ", expecting [0, ", n_fvalues, ")"));
 
-            cache.m_acc.update(gradients.array(samples(i)), fv);
-        }
+                cache.m_acc.update<tsize>(gradients.vector(samples(i)).data(), fv);
+            }
+        });
 
         // update the parameters if a better feature
         const auto score = cache.score();
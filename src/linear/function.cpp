@@ -1,23 +1,141 @@
+#include <Eigen/Cholesky>
+#include <nano/loss/flatten.h>
 #include <nano/linear/util.h>
 #include <nano/linear/cache.h>
+#include <nano/dataset/sparse.h>
 #include <nano/linear/function.h>
 
 using namespace nano;
 
-linear_function_t::linear_function_t(const loss_t& loss, const dataset_t& dataset, const indices_t& samples) :
+namespace
+{
+    ///
+    /// \brief returns the given batch of inputs in double precision,
+    ///     so that the gradients are cumulated over the samples in double precision.
+    ///
+    /// NB: the single precision inputs are converted into the (per-thread) cache buffer.
+    ///
+    template <typename tmatrix>
+    auto inputs64(const tmatrix& imatrix, linear_cache_t& cache)
+    {
+        if constexpr (std::is_same_v<typename tmatrix::Scalar, scalar_t>)
+        {
+            return imatrix;
+        }
+        else
+        {
+            cache.m_inputs.resize(imatrix.rows(), imatrix.cols(), 1, 1);
+
+            auto dmatrix = cache.m_inputs.reshape(imatrix.rows(), imatrix.cols()).matrix();
+            dmatrix = imatrix.template cast<scalar_t>();
+            return cache.m_inputs.reshape(imatrix.rows(), imatrix.cols()).matrix();
+        }
+    }
+}
+
+linear_function_t::linear_function_t(const loss_t& loss, const dataset_t& dataset, const indices_t& samples,
+    const ::nano::normalization normalization, const ::nano::precision precision) :
     function_t("linear", (::nano::size(dataset.idim()) + 1) * ::nano::size(dataset.tdim()), convexity::yes),
     m_loss(loss),
     m_dataset(dataset),
     m_samples(samples),
+    m_sparse(dynamic_cast<const sparse_dataset_t*>(&dataset)),
     m_isize(::nano::size(dataset.idim())),
     m_tsize(::nano::size(dataset.tdim())),
-    m_istats(m_dataset.istats(m_samples, batch()))
+    m_normalization(m_sparse != nullptr ? ::nano::normalization::none : normalization),
+    m_precision(m_sparse != nullptr ? ::nano::precision::f64 : precision),
+    m_istats(m_sparse != nullptr ? elemwise_stats_t{} : m_dataset.istats(m_samples, batch())),
+    m_targets(cat_dims(samples.size(), dataset.tdim()))
 {
     assert(m_isize > 0);
     assert(m_tsize > 0);
+
+    loopr(m_samples.size(), batch(), [&] (tensor_size_t begin, tensor_size_t end, size_t)
+    {
+        const auto range = make_range(begin, end);
+        m_targets.slice(range) = m_dataset.targets(m_samples.slice(range));
+    });
+
+    update_inputs();
+}
+
+void linear_function_t::normalization(const ::nano::normalization normalization)
+{
+    if (normalization != m_normalization && m_sparse == nullptr)
+    {
+        m_normalization = normalization;
+        update_inputs();
+    }
+}
+
+void linear_function_t::precision(const ::nano::precision precision)
+{
+    if (precision != m_precision && m_sparse == nullptr)
+    {
+        m_precision = precision;
+        update_inputs();
+    }
+}
+
+void linear_function_t::update_inputs()
+{
+    const auto single = precision() == ::nano::precision::f32;
+
+    m_inputs.resize(cat_dims((single || m_sparse != nullptr) ? 0 : m_samples.size(), m_dataset.idim()));
+    m_inputs32.resize(cat_dims((single && m_sparse == nullptr) ? m_samples.size() : 0, m_dataset.idim()));
+
+    tensor_size_t ibytes = 0;
+    if (m_sparse != nullptr)
+    {
+        const auto& offsets = m_sparse->offsets();
+        for (tensor_size_t i = 0; i < m_samples.size(); ++ i)
+        {
+            const auto sample = m_samples(i);
+            ibytes += offsets(sample + 1) - offsets(sample);
+        }
+        ibytes *= static_cast<tensor_size_t>(sizeof(tensor_size_t) + sizeof(scalar_t));
+    }
+    else
+    {
+        loopr(m_samples.size(), batch(), [&] (tensor_size_t begin, tensor_size_t end, size_t)
+        {
+            const auto range = make_range(begin, end);
+
+            auto inputs = m_dataset.inputs(m_samples.slice(range));
+            m_istats.scale(normalization(), inputs);
+
+            if (single)
+            {
+                m_inputs32.slice(range).array() = inputs.array().template cast<float>();
+            }
+            else
+            {
+                m_inputs.slice(range) = inputs;
+            }
+        });
+
+        ibytes =
+            m_inputs.size() * static_cast<tensor_size_t>(sizeof(scalar_t)) +
+            m_inputs32.size() * static_cast<tensor_size_t>(sizeof(float));
+    }
+
+    m_bytes = ibytes + m_targets.size() * static_cast<tensor_size_t>(sizeof(scalar_t)) + function_t::bytes();
 }
 
 scalar_t linear_function_t::vgrad(const vector_t& x, vector_t* gx) const
+{
+    return evaluate(x, nullptr, gx);
+}
+
+scalar_t linear_function_t::partial_vgrad(const vector_t& x, const indices_cmap_t& summands, vector_t* gx) const
+{
+    assert(summands.size() > 0);
+    assert(summands.min() >= 0 && summands.max() < m_samples.size());
+
+    return evaluate(x, &summands, gx);
+}
+
+scalar_t linear_function_t::evaluate(const vector_t& x, const indices_cmap_t* summands, vector_t* gx) const
 {
     assert(!gx || gx->size() == x.size());
     assert(x.size() == (m_isize + 1) * m_tsize);
@@ -27,18 +145,26 @@ scalar_t linear_function_t::vgrad(const vector_t& x, vector_t* gx) const
 
     std::vector<linear_cache_t> caches(tpool_t::size(), linear_cache_t{m_isize, m_tsize, gx != nullptr, vAreg() > 0});
 
-    loopr(m_samples.size(), batch(), [&] (tensor_size_t begin, tensor_size_t end, size_t tnum)
+    // NB: the linear transformations are computed in the precision of the cached inputs,
+    //  while the loss values and the gradients are cumulated in double precision.
+    const auto accumulate = [&] (const auto& inputs, const auto& targets, const auto& W, linear_cache_t& cache)
     {
-        assert(tnum < caches.size());
-        auto& cache = caches[tnum];
+        const auto size = targets.template size<0>();
+        const auto imatrix = inputs.reshape(size, W.rows()).matrix();
 
-        const auto range = make_range(begin, end);
-        auto inputs = m_dataset.inputs(m_samples.slice(range));
-        const auto targets = m_dataset.targets(m_samples.slice(range));
+        cache.m_outputs.resize(size, m_tsize, 1, 1);
+        auto omatrix = cache.m_outputs.reshape(size, m_tsize).matrix();
+        omatrix = (imatrix * W).template cast<scalar_t>();
+        omatrix.rowwise() += b.vector().transpose();
 
-        m_istats.scale(normalization(), inputs);
-        ::nano::linear::predict(inputs, W, b, cache.m_outputs);
-        m_loss.value(targets, cache.m_outputs, cache.m_values);
+        if (gx != nullptr)
+        {
+            m_loss.value_vgrad(targets, cache.m_outputs, cache.m_values, cache.m_vgrads);
+        }
+        else
+        {
+            m_loss.value(targets, cache.m_outputs, cache.m_values);
+        }
 
         const auto vvector = cache.m_values.vector();
 
@@ -50,23 +176,149 @@ scalar_t linear_function_t::vgrad(const vector_t& x, vector_t* gx) const
 
         if (gx != nullptr)
         {
-            m_loss.vgrad(targets, cache.m_outputs, cache.m_vgrads);
-
-            const auto imatrix = inputs.reshape(range.size(), W.rows()).matrix();
-            const auto gmatrix = cache.m_vgrads.reshape(range.size(), W.cols()).matrix();
+            const auto gmatrix = cache.m_vgrads.reshape(size, W.cols()).matrix();
+            const auto dmatrix = inputs64(imatrix, cache);
 
             cache.m_gb1.vector() += gmatrix.colwise().sum();
-            cache.m_gW1.matrix() += imatrix.transpose() * gmatrix;
+            cache.m_gW1.matrix().noalias() += dmatrix.transpose() * gmatrix;
+
+            if (vAreg() > 0)
+            {
+                cache.m_gb2.vector() += gmatrix.transpose() * vvector;
+                cache.m_gW2.matrix().noalias() +=
+                    (dmatrix.array().colwise() * vvector.array()).matrix().transpose() * gmatrix;
+            }
+        }
+    };
+
+    // NB: the sparse inputs are processed directly from the dataset (sparse x dense products and scatter-add gradients).
+    const auto accumulate_sparse = [&] (const tensor_size_t begin, const tensor_size_t end, linear_cache_t& cache)
+    {
+        const auto size = end - begin;
+        const auto& findices = m_sparse->findices();
+        const auto& fvalues = m_sparse->fvalues();
+        const auto& offsets = m_sparse->offsets();
+
+        cache.m_indices.resize(size);
+        cache.m_targets.resize(cat_dims(size, m_dataset.tdim()));
+        for (tensor_size_t i = 0; i < size; ++ i)
+        {
+            const auto index = (summands == nullptr) ? (begin + i) : (*summands)(begin + i);
+            cache.m_indices(i) = m_samples(index);
+            cache.m_targets.vector(i) = m_targets.vector(index);
+        }
+
+        cache.m_outputs.resize(size, m_tsize, 1, 1);
+        ::nano::linear::predict(offsets, findices, fvalues, cache.m_indices, W, b, cache.m_outputs.tensor());
+
+        if (gx != nullptr)
+        {
+            m_loss.value_vgrad(cache.m_targets, cache.m_outputs, cache.m_values, cache.m_vgrads);
+        }
+        else
+        {
+            m_loss.value(cache.m_targets, cache.m_outputs, cache.m_values);
+        }
+
+        const auto vvector = cache.m_values.vector();
 
+        cache.m_vm1 += vvector.array().sum();
+        if (vAreg() > 0)
+        {
+            cache.m_vm2 += vvector.array().square().sum();
+        }
+
+        if (gx != nullptr)
+        {
+            const auto gmatrix = cache.m_vgrads.reshape(size, m_tsize).matrix();
+
+            cache.m_gb1.vector() += gmatrix.colwise().sum();
             if (vAreg() > 0)
             {
                 cache.m_gb2.vector() += gmatrix.transpose() * vvector;
-                cache.m_gW2.matrix() += (imatrix.array().colwise() * vvector.array()).matrix().transpose() * gmatrix;
+            }
+
+            auto gW1 = cache.m_gW1.matrix();
+            auto gW2 = cache.m_gW2.matrix();
+            for (tensor_size_t i = 0; i < size; ++ i)
+            {
+                const auto sample = cache.m_indices(i);
+                for (auto k = offsets(sample), kend = offsets(sample + 1); k < kend; ++ k)
+                {
+                    gW1.row(findices(k)) += fvalues(k) * gmatrix.row(i);
+                    if (vAreg() > 0)
+                    {
+                        gW2.row(findices(k)) += (fvalues(k) * vvector(i)) * gmatrix.row(i);
+                    }
+                }
+            }
+        }
+    };
+
+    const auto single = precision() == ::nano::precision::f32;
+    const auto W32 = single ? tensor_matrix_t<float>(W.matrix().template cast<float>()) : tensor_matrix_t<float>{};
+
+    // NB: the given subset of samples (if any) is gathered into contiguous per-thread buffers.
+    const auto samples = (summands == nullptr) ? m_samples.size() : summands->size();
+
+    // NB: the (usually small) mini-batches of the stochastic solvers are split across all threads
+    const auto threads = static_cast<tensor_size_t>(tpool_t::size());
+    const auto chunk = (summands == nullptr) ? static_cast<tensor_size_t>(batch()) :
+        std::clamp((samples + threads - 1) / threads, tensor_size_t(1), static_cast<tensor_size_t>(batch()));
+
+    loopr(samples, chunk, [&] (tensor_size_t begin, tensor_size_t end, size_t tnum)
+    {
+        assert(tnum < caches.size());
+        auto& cache = caches[tnum];
+
+        const auto range = make_range(begin, end);
+        if (m_sparse != nullptr)
+        {
+            accumulate_sparse(begin, end, cache);
+        }
+        else if (summands == nullptr)
+        {
+            if (single)
+            {
+                accumulate(m_inputs32.slice(range), m_targets.slice(range), W32, cache);
+            }
+            else
+            {
+                accumulate(m_inputs.slice(range), m_targets.slice(range), W.matrix(), cache);
+            }
+        }
+        else
+        {
+            const auto indices = summands->slice(range);
+
+            cache.m_targets.resize(cat_dims(range.size(), m_dataset.tdim()));
+            for (tensor_size_t i = 0; i < range.size(); ++ i)
+            {
+                cache.m_targets.vector(i) = m_targets.vector(indices(i));
+            }
+
+            if (single)
+            {
+                cache.m_inputs32.resize(cat_dims(range.size(), m_dataset.idim()));
+                for (tensor_size_t i = 0; i < range.size(); ++ i)
+                {
+                    cache.m_inputs32.vector(i) = m_inputs32.vector(indices(i));
+                }
+                accumulate(cache.m_inputs32, cache.m_targets, W32, cache);
+            }
+            else
+            {
+                cache.m_inputs.resize(cat_dims(range.size(), m_dataset.idim()));
+                for (tensor_size_t i = 0; i < range.size(); ++ i)
+                {
+                    cache.m_inputs.vector(i) = m_inputs.vector(indices(i));
+                }
+                accumulate(cache.m_inputs, cache.m_targets, W.matrix(), cache);
             }
         }
     });
 
-    const auto& cache0 = linear_cache_t::reduce(caches, m_samples.size());
+    const auto& cache0 = linear_cache_t::reduce(caches, samples);
 
     // OK, normalize and add the regularization terms
     if (gx != nullptr)
@@ -97,3 +349,201 @@ scalar_t linear_function_t::vgrad(const vector_t& x, vector_t* gx) const
             ((l2reg() > 0) ? (l2reg() * W.array().square().mean()) : scalar_t(0)) +
             ((vAreg() > 0) ? (vAreg() * (cache0.m_vm2 - cache0.m_vm1 * cache0.m_vm1)) : scalar_t(0));
 }
+
+void linear_function_t::hvp(const vector_t& x, const vector_t& v, vector_t& hv) const
+{
+    assert(x.size() == size());
+    assert(v.size() == size());
+
+    if (vAreg() > 0)
+    {
+        function_t::hvp(x, v, hv);
+        return;
+    }
+
+    const auto b = bias(x);
+    const auto W = weights(x);
+    const auto vb = bias(v);
+    const auto vW = weights(v);
+
+    std::vector<linear_cache_t> caches(tpool_t::size(), linear_cache_t{m_isize, m_tsize, true, false});
+
+    // NB: replace the gradients wrt predictions with the loss' Hessian-vector products D_i * u_i,
+    //  given the predictions o_i (m_outputs) and their directional derivatives u_i (m_doutputs).
+    const auto directional = [&] (const auto& targets, linear_cache_t& cache)
+    {
+        m_loss.hvp(targets, cache.m_outputs, cache.m_doutputs, cache.m_vgrads);
+    };
+
+    const auto accumulate = [&] (const auto& inputs, const auto& targets, const auto& W, const auto& vW,
+        linear_cache_t& cache)
+    {
+        const auto size = targets.template size<0>();
+        const auto imatrix = inputs.reshape(size, W.rows()).matrix();
+
+        cache.m_outputs.resize(size, m_tsize, 1, 1);
+        auto omatrix = cache.m_outputs.reshape(size, m_tsize).matrix();
+        omatrix = (imatrix * W).template cast<scalar_t>();
+        omatrix.rowwise() += b.vector().transpose();
+
+        cache.m_doutputs.resize(size, m_tsize, 1, 1);
+        auto umatrix = cache.m_doutputs.reshape(size, m_tsize).matrix();
+        umatrix = (imatrix * vW).template cast<scalar_t>();
+        umatrix.rowwise() += vb.vector().transpose();
+
+        directional(targets, cache);
+
+        const auto gmatrix = cache.m_vgrads.reshape(size, m_tsize).matrix();
+        const auto dmatrix = inputs64(imatrix, cache);
+
+        cache.m_gb1.vector() += gmatrix.colwise().sum();
+        cache.m_gW1.matrix().noalias() += dmatrix.transpose() * gmatrix;
+    };
+
+    const auto accumulate_sparse = [&] (const tensor_size_t begin, const tensor_size_t end, linear_cache_t& cache)
+    {
+        const auto size = end - begin;
+        const auto& findices = m_sparse->findices();
+        const auto& fvalues = m_sparse->fvalues();
+        const auto& offsets = m_sparse->offsets();
+
+        const auto range = make_range(begin, end);
+        const auto samples = m_samples.slice(range);
+        const auto targets = m_targets.slice(range);
+
+        cache.m_outputs.resize(size, m_tsize, 1, 1);
+        ::nano::linear::predict(offsets, findices, fvalues, samples, W, b, cache.m_outputs.tensor());
+
+        cache.m_doutputs.resize(size, m_tsize, 1, 1);
+        ::nano::linear::predict(offsets, findices, fvalues, samples, vW, vb, cache.m_doutputs.tensor());
+
+        directional(targets, cache);
+
+        const auto gmatrix = cache.m_vgrads.reshape(size, m_tsize).matrix();
+
+        cache.m_gb1.vector() += gmatrix.colwise().sum();
+
+        auto gW1 = cache.m_gW1.matrix();
+        for (tensor_size_t i = 0; i < size; ++ i)
+        {
+            const auto sample = samples(i);
+            for (auto k = offsets(sample), kend = offsets(sample + 1); k < kend; ++ k)
+            {
+                gW1.row(findices(k)) += fvalues(k) * gmatrix.row(i);
+            }
+        }
+    };
+
+    const auto single = precision() == ::nano::precision::f32;
+    const auto W32 = single ? tensor_matrix_t<float>(W.matrix().template cast<float>()) : tensor_matrix_t<float>{};
+    const auto vW32 = single ? tensor_matrix_t<float>(vW.matrix().template cast<float>()) : tensor_matrix_t<float>{};
+
+    loopr(m_samples.size(), batch(), [&] (tensor_size_t begin, tensor_size_t end, size_t tnum)
+    {
+        assert(tnum < caches.size());
+        auto& cache = caches[tnum];
+
+        const auto range = make_range(begin, end);
+        if (m_sparse != nullptr)
+        {
+            accumulate_sparse(begin, end, cache);
+        }
+        else if (single)
+        {
+            accumulate(m_inputs32.slice(range), m_targets.slice(range), W32, vW32, cache);
+        }
+        else
+        {
+            accumulate(m_inputs.slice(range), m_targets.slice(range), W.matrix(), vW.matrix(), cache);
+        }
+    });
+
+    const auto& cache0 = linear_cache_t::reduce(caches, m_samples.size());
+
+    // OK, add the Hessian of the regularization term
+    //  NB: the L1-norm is piecewise linear, so its Hessian is zero almost everywhere.
+    hv.resize(size());
+
+    auto hb = bias(hv);
+    auto hW = weights(hv);
+
+    hb = cache0.m_gb1;
+    hW = cache0.m_gW1;
+
+    if (l2reg() > 0)
+    {
+        hW.array() += l2reg() * vW.array() * 2 / W.size();
+    }
+}
+
+tensor_size_t linear_function_t::hvp_bytes() const
+{
+    return (vAreg() > 0) ? function_t::hvp_bytes() : bytes();
+}
+
+bool linear_function_t::closed_form() const
+{
+    return  dynamic_cast<const squared_loss_t*>(&m_loss) != nullptr &&
+            l1reg() <= 0 && vAreg() <= 0 && m_sparse == nullptr;
+}
+
+vector_t linear_function_t::solve() const
+{
+    critical(
+        !closed_form(),
+        "linear function: the optimum can be computed in closed form only for the L2-regularized squared loss!");
+
+    // NB: the bias is modeled as the weight of an implicit constant input feature,
+    //  as the parameters are stored as [W; b^T] (see weights() and bias()).
+    std::vector<matrix_t> xxs(tpool_t::size(), matrix_t::Zero(m_isize + 1, m_isize + 1));
+    std::vector<matrix_t> xys(tpool_t::size(), matrix_t::Zero(m_isize + 1, m_tsize));
+
+    const auto single = precision() == ::nano::precision::f32;
+
+    loopr(m_samples.size(), batch(), [&] (tensor_size_t begin, tensor_size_t end, size_t tnum)
+    {
+        assert(tnum < xxs.size());
+        auto& xx = xxs[tnum];
+        auto& xy = xys[tnum];
+
+        const auto range = make_range(begin, end);
+        const auto tmatrix = m_targets.slice(range).reshape(range.size(), m_tsize).matrix();
+
+        const auto cumulate = [&] (const auto& imatrix)
+        {
+            xx.topLeftCorner(m_isize, m_isize).noalias() += imatrix.transpose() * imatrix;
+            xx.bottomLeftCorner(1, m_isize) += imatrix.colwise().sum();
+            xx(m_isize, m_isize) += static_cast<scalar_t>(range.size());
+
+            xy.topRows(m_isize).noalias() += imatrix.transpose() * tmatrix;
+            xy.bottomRows(1) += tmatrix.colwise().sum();
+        };
+
+        if (single)
+        {
+            cumulate(m_inputs32.slice(range).reshape(range.size(), m_isize).matrix().template cast<scalar_t>().eval());
+        }
+        else
+        {
+            cumulate(m_inputs.slice(range).reshape(range.size(), m_isize).matrix());
+        }
+    });
+
+    for (size_t i = 1; i < xxs.size(); ++ i)
+    {
+        xxs[0] += xxs[i];
+        xys[0] += xys[i];
+    }
+
+    auto& xx = xxs[0];
+    xx.topRightCorner(m_isize, 1) = xx.bottomLeftCorner(1, m_isize).transpose();
+
+    // NB: the gradient of the regularization term is 2 * l2reg * W / W.size(),
+    //  while the data term is normalized by the number of samples.
+    const auto lambda = 2 * l2reg() * static_cast<scalar_t>(m_samples.size()) / static_cast<scalar_t>(m_isize * m_tsize);
+    xx.diagonal().head(m_isize).array() += lambda;
+
+    vector_t x(size());
+    map_matrix(x.data(), m_isize + 1, m_tsize) = xx.ldlt().solve(xys[0]);
+    return x;
+}
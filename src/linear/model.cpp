@@ -1,11 +1,30 @@
+#include <algorithm>
+#include <functional>
 #include <iomanip>
 #include <nano/linear/util.h>
 #include <nano/linear/model.h>
+#include <nano/linear/proximal.h>
 #include <nano/tensor/stream.h>
 #include <nano/linear/function.h>
+#include <nano/dataset/sparse.h>
 
 using namespace nano;
 
+static void predict(const dataset_t& dataset, const indices_cmap_t& samples,
+    const tensor2d_cmap_t& weights, const tensor1d_cmap_t& bias, tensor4d_map_t&& outputs)
+{
+    // NB: the sparse inputs are processed directly without being materialized densely.
+    if (const auto* sparse = dynamic_cast<const sparse_dataset_t*>(&dataset); sparse != nullptr)
+    {
+        ::nano::linear::predict(sparse->offsets(), sparse->findices(), sparse->fvalues(),
+            samples, weights, bias, std::move(outputs));
+    }
+    else
+    {
+        ::nano::linear::predict(dataset.inputs(samples), weights, bias, std::move(outputs));
+    }
+}
+
 linear_model_t::linear_model_t()
 {
     model_t::register_param(iparam1_t{"linear::batch", 1, LE, 32, LE, 4096});
@@ -13,6 +32,7 @@ linear_model_t::linear_model_t()
     model_t::register_param(sparam1_t{"linear::l2reg", 0, LE, 0, LE, 1e+10});
     model_t::register_param(sparam1_t{"linear::vAreg", 0, LE, 0, LE, 1e+10});
     model_t::register_param(eparam1_t{"linear::normalization", ::nano::normalization::standard});
+    model_t::register_param(eparam1_t{"linear::precision", ::nano::precision::f64});
 }
 
 rmodel_t linear_model_t::clone() const
@@ -20,16 +40,8 @@ rmodel_t linear_model_t::clone() const
     return std::make_unique<linear_model_t>(*this);
 }
 
-scalar_t linear_model_t::fit(
-    const loss_t& loss, const dataset_t& dataset, const indices_t& samples, const solver_t& solver)
+static void check_features(const dataset_t& dataset)
 {
-    log_info() << string_t(8, '-') << ::nano::align(" gboost model ", 112U, alignment::left, '-') << string_t(8, '-');
-    for (const auto& param : params())
-    {
-        log_info() << "gboost model: fit using " << std::fixed << std::setprecision(8) << param;
-    }
-    log_info() << string_t(128, '-');
-
     for (size_t ifeature = 0U, features = dataset.features(); ifeature < features; ++ ifeature)
     {
         const auto feature = dataset.feature(ifeature);
@@ -37,15 +49,43 @@ scalar_t linear_model_t::fit(
             feature.discrete() || feature.optional(),
             "linear model: cannot fit datasets containing discrete features or with missing feature values!");
     }
+}
 
-    auto function = linear_function_t{loss, dataset, samples};
+linear_function_t linear_model_t::make_function(
+    const loss_t& loss, const dataset_t& dataset, const indices_t& samples) const
+{
+    // NB: the inputs are cached (normalized and converted) only once at construction!
+    auto function = linear_function_t{loss, dataset, samples, normalization(), precision()};
     function.batch(batch());
     function.l1reg(l1reg());
     function.l2reg(l2reg());
     function.vAreg(vAreg());
-    function.normalization(normalization());
+    return function;
+}
+
+solver_state_t linear_model_t::minimize(linear_function_t& function, const solver_t& solver, const vector_t& x0)
+{
+    function.l1reg(l1reg());
+    function.l2reg(l2reg());
+    function.vAreg(vAreg());
+
+    // NB: solve directly the normal equations if possible instead of running the given iterative solver!
+    // NB: use the proximal gradient method for the non-smooth L1-norm regularization!
+    auto state = solver_state_t{};
+    if (function.closed_form())
+    {
+        state = solver_state_t{function, function.solve()};
+        state.m_status = solver_state_t::status::converged;
+    }
+    else if (function.l1reg() > 0)
+    {
+        state = ::nano::linear::fista(function, x0, solver.epsilon(), solver.max_iterations());
+    }
+    else
+    {
+        state = solver.minimize(function, x0);
+    }
 
-    const auto state = solver.minimize(function, vector_t::Zero(function.size()));
     m_bias = function.bias(state.x);
     m_weights = function.weights(state.x);
 
@@ -53,18 +93,25 @@ scalar_t linear_model_t::fit(
     const auto& istats = function.istats();
     istats.upscale(function.normalization(), m_weights, m_bias);
 
-    tensor1d_t errors(samples.size());
-    tensor4d_t outputs(cat_dims(samples.size(), dataset.tdim()));
+    return state;
+}
 
-    loopr(samples.size(), batch(), [&] (tensor_size_t begin, tensor_size_t end, size_t)
+scalar_t linear_model_t::fit(
+    const loss_t& loss, const dataset_t& dataset, const indices_t& samples, const solver_t& solver)
+{
+    log_info() << string_t(8, '-') << ::nano::align(" gboost model ", 112U, alignment::left, '-') << string_t(8, '-');
+    for (const auto& param : params())
     {
-        const auto range = make_range(begin, end);
-        const auto inputs = dataset.inputs(samples.slice(range));
-        const auto targets = dataset.targets(samples.slice(range));
+        log_info() << "gboost model: fit using " << std::fixed << std::setprecision(8) << param;
+    }
+    log_info() << string_t(128, '-');
 
-        ::nano::linear::predict(inputs, m_weights, m_bias, outputs.slice(range));
-        loss.error(targets.tensor(), outputs.slice(range), errors.slice(range));
-    });
+    check_features(dataset);
+
+    auto function = make_function(loss, dataset, samples);
+    const auto state = minimize(function, solver, vector_t::Zero(function.size()));
+
+    const auto errors = evaluate(loss, dataset, samples);
 
     const auto tr_value = state.f;
     const auto tr_error = errors.vector().mean();
@@ -78,6 +125,44 @@ scalar_t linear_model_t::fit(
     return tr_error;
 }
 
+std::vector<linear_model_t> linear_model_t::fit(
+    const loss_t& loss, const dataset_t& dataset, const indices_t& samples, const solver_t& solver,
+    const string_t& param, std::vector<scalar_t> values)
+{
+    critical(
+        param != "linear::l1reg" && param != "linear::l2reg" && param != "linear::vAreg",
+        scat("linear model: invalid regularization parameter (", param, ") for fitting the regularization path!"));
+
+    critical(
+        values.empty(),
+        "linear model: at least one regularization factor is needed for fitting the regularization path!");
+
+    check_features(dataset);
+
+    // NB: start with the most regularized problem, as its solution is the closest to the origin!
+    std::sort(values.begin(), values.end(), std::greater<>());
+
+    std::vector<linear_model_t> models;
+    models.reserve(values.size());
+
+    auto function = make_function(loss, dataset, samples);
+    auto x = vector_t{vector_t::Zero(function.size())};
+    for (const auto value : values)
+    {
+        set(param, value);
+
+        const auto state = minimize(function, solver, x);
+        x = state.x;
+
+        log_info() << std::setprecision(8) << std::fixed
+            << "linear: path " << param << "=" << value << ",tr=" << state.f << "," << state << ".";
+
+        models.push_back(*this);
+    }
+
+    return models;
+}
+
 void linear_model_t::read(std::istream& stream)
 {
     model_t::read(stream);
@@ -108,10 +193,14 @@ tensor4d_t linear_model_t::predict(const dataset_t& dataset, const indices_t& sa
     loopr(samples.size(), batch(), [&] (tensor_size_t begin, tensor_size_t end, size_t)
     {
         const auto range = make_range(begin, end);
-        const auto inputs = dataset.inputs(samples.slice(range));
 
-        ::nano::linear::predict(inputs, m_weights, m_bias, outputs.slice(range));
+        predict(dataset, samples.slice(range), outputs.slice(range));
     });
 
     return outputs;
 }
+
+void linear_model_t::predict(const dataset_t& dataset, const indices_cmap_t& samples, tensor4d_map_t outputs) const
+{
+    ::predict(dataset, samples, m_weights, m_bias, std::move(outputs));
+}
@@ -0,0 +1,147 @@
+#include <nano/linear/proximal.h>
+
+using namespace nano;
+
+namespace
+{
+    ///
+    /// \brief disable the L1-norm regularization of the given function while in scope,
+    ///     so that only the smooth part of the criterion is evaluated.
+    ///
+    /// NB: the original regularization factor is restored even if an exception is thrown.
+    ///
+    class smooth_guard_t
+    {
+    public:
+
+        explicit smooth_guard_t(linear_function_t& function) :
+            m_function(function),
+            m_l1reg(function.l1reg())
+        {
+            m_function.l1reg(0);
+        }
+
+        smooth_guard_t(const smooth_guard_t&) = delete;
+        smooth_guard_t& operator=(const smooth_guard_t&) = delete;
+
+        smooth_guard_t(smooth_guard_t&&) = delete;
+        smooth_guard_t& operator=(smooth_guard_t&&) = delete;
+
+        ~smooth_guard_t()
+        {
+            m_function.l1reg(m_l1reg);
+        }
+
+    private:
+
+        // attributes
+        linear_function_t&  m_function;     ///<
+        scalar_t            m_l1reg{0};     ///< original L1-norm regularization factor
+    };
+}
+
+solver_state_t linear::fista(
+    linear_function_t& function, const vector_t& x0, const scalar_t epsilon, const int64_t max_iterations)
+{
+    assert(x0.size() == function.size());
+
+    const auto l1reg = function.l1reg();
+    const auto lambda = l1reg / static_cast<scalar_t>(function.isize() * function.tsize());
+
+    const auto penalty = [&] (const vector_t& x)
+    {
+        return lambda * function.weights(x).array().abs().sum();
+    };
+
+    // NB: the proximal operator of the L1-norm is applied only to the weights (not to the bias)!
+    const auto prox = [&] (const vector_t& y, const vector_t& gy, const scalar_t L, vector_t& z)
+    {
+        z = y - gy / L;
+
+        auto w = function.weights(z).array();
+        w = w.sign() * (w.abs() - lambda / L).max(scalar_t(0));
+    };
+
+    vector_t x = x0, y = x0, z = x0, gy(x0.size());
+
+    auto status = solver_state_t::status::max_iters;
+    auto iterations = int64_t{0};
+    {
+        // NB: the smooth part of the criterion is evaluated without the L1-norm regularization term!
+        const smooth_guard_t smooth{function};
+
+        auto fx = function.vgrad(x) + penalty(x);
+        auto fy = function.vgrad(y, &gy);
+
+        scalar_t L = 1, tk = 1;
+        for ( ; iterations < max_iterations; ++ iterations)
+        {
+            // backtracking to estimate the Lipschitz constant of the gradient
+            auto fz = scalar_t(0);
+            for (auto trials = 0; trials < 100; ++ trials)
+            {
+                prox(y, gy, L, z);
+                fz = function.vgrad(z);
+                if (fz <= fy + gy.dot(z - y) + 0.5 * L * (z - y).squaredNorm())
+                {
+                    break;
+                }
+                L *= 2;
+            }
+
+            const auto Fz = fz + penalty(z);
+            if (!std::isfinite(Fz))
+            {
+                status = solver_state_t::status::failed;
+                break;
+            }
+
+            // convergence criterion: the gradient mapping is relatively small
+            const auto converged = L * (y - z).lpNorm<Eigen::Infinity>() < epsilon * std::max(scalar_t(1), std::fabs(Fz));
+
+            // momentum step, restarted if the criterion increases
+            if (Fz > fx)
+            {
+                tk = 1;
+                y = x;
+            }
+            else
+            {
+                const auto tk1 = 0.5 * (1 + std::sqrt(1 + 4 * tk * tk));
+                y = z + ((tk - 1) / tk1) * (z - x);
+                tk = tk1;
+                x = z;
+                fx = Fz;
+            }
+
+            if (converged)
+            {
+                status = solver_state_t::status::converged;
+                ++ iterations;
+                break;
+            }
+
+            fy = function.vgrad(y, &gy);
+        }
+    }
+
+    // OK, evaluate the full criterion at the solution and store the minimum-norm subgradient
+    auto state = solver_state_t{function, x};
+    {
+        const smooth_guard_t smooth{function};
+
+        vector_t gx(x.size());
+        function.vgrad(x, &gx);
+
+        const auto w = function.weights(x).array();
+        const auto gw = function.weights(gx).array();
+        function.weights(state.g).array() = (w != 0).select(
+            gw + lambda * w.sign(),
+            gw.sign() * (gw.abs() - lambda).max(scalar_t(0)));
+        function.bias(state.g).vector() = function.bias(gx).vector();
+    }
+    state.m_status = status;
+    state.m_iterations = iterations;
+
+    return state;
+}
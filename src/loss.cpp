@@ -1,4 +1,5 @@
 #include <mutex>
+#include <nano/numeric.h>
 #include <nano/loss/flatten.h>
 
 using namespace nano;
@@ -34,3 +35,31 @@ loss_factory_t& loss_t::all()
 
     return manager;
 }
+
+void loss_t::hvp(const tensor4d_cmap_t& targets, const tensor4d_cmap_t& outputs,
+    const tensor4d_cmap_t& u, tensor4d_map_t hu) const
+{
+    assert(targets.dims() == hu.dims());
+    assert(targets.dims() == outputs.dims());
+    assert(targets.dims() == u.dims());
+
+    const auto unorm = u.vector().lpNorm<Eigen::Infinity>();
+    if (unorm < std::numeric_limits<scalar_t>::epsilon())
+    {
+        hu.zero();
+        return;
+    }
+
+    const auto dt = epsilon3<scalar_t>() * (1 + outputs.vector().lpNorm<Eigen::Infinity>()) / unorm;
+
+    tensor4d_t doutputs(outputs.dims());
+    tensor4d_t dvgrads(outputs.dims());
+
+    doutputs.vector() = outputs.vector() + dt * u.vector();
+    vgrad(targets, doutputs, hu);
+
+    doutputs.vector() = outputs.vector() - dt * u.vector();
+    vgrad(targets, doutputs, dvgrads.tensor());
+
+    hu.vector() = (hu.vector() - dvgrads.vector()) / (2 * dt);
+}
@@ -63,5 +63,8 @@ bool lsearchk_t::get(solver_state_t& state, scalar_t t)
     // line-search step length
     // NB: some line-search algorithms (see CGDESCENT) allow a small increase
     //     in the function value when close to numerical precision!
-    return get(state0, state) && state;
+    // NB: the next trials may evaluate only the function value (e.g. when checking only the Armijo condition),
+    //  so make sure the gradient is evaluated at the returned step length.
+    const auto ok = get(state0, state);
+    return state.update_grad() && ok;
 }
@@ -17,7 +17,19 @@ bool lsearchk_backtrack_t::get(const solver_state_t& state0, solver_state_t& sta
         }
 
         // next trial
-        state.update(state0, lsearch_step_t::interpolate(state0, state, m_interpolation));
+        // NB: only the function value is needed to check the Armijo condition,
+        //  but the gradient is evaluated eagerly until the second rejection as the trial is likely accepted
+        //  (otherwise both the value and the gradient would be evaluated again at the accepted trial)
+        //  or if the cubic interpolation needs the slope at the rejected trial.
+        const auto t = lsearch_step_t::interpolate(state0, state, m_interpolation);
+        if (i < 1 || m_interpolation == interpolation::cubic)
+        {
+            state.update(state0, t);
+        }
+        else
+        {
+            state.update_value(state0, t);
+        }
         log(state0, state);
     }
 
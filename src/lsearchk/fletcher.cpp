@@ -11,12 +11,16 @@ rlsearchk_t lsearchk_fletcher_t::clone() const
 bool lsearchk_fletcher_t::zoom(const solver_state_t& state0,
     lsearch_step_t lo, lsearch_step_t hi, solver_state_t& state) const
 {
+    // NB: the trials are usually accepted and thus evaluated with the gradient,
+    //  unless the previous two trials are rejected when only the function value is needed to reject them.
+    int64_t rejections = 0;
     for (int64_t i = 0; i < max_iterations() && std::fabs(lo.t - hi.t) > epsilon0<scalar_t>(); ++ i)
     {
         const auto tmin = lo.t + std::min(tau2(), c2()) * (hi.t - lo.t);
         const auto tmax = hi.t - tau3() * (hi.t - lo.t);
         const auto next = lsearch_step_t::interpolate(lo, hi, m_interpolation);
-        const auto ok = state.update(state0, clamp(next, std::min(tmin, tmax), std::max(tmin, tmax)));
+        const auto t = clamp(next, std::min(tmin, tmax), std::max(tmin, tmax));
+        const auto ok = (rejections < 2) ? state.update(state0, t) : state.update_value(state0, t);
         log(state0, state);
 
         if (!ok)
@@ -26,10 +30,15 @@ bool lsearchk_fletcher_t::zoom(const solver_state_t& state0,
         else if (!state.has_armijo(state0, c1()) || state.f >= lo.f)
         {
             hi = state;
+            ++ rejections;
         }
         else
         {
-            if (state.has_strong_wolfe(state0, c2()))
+            if (!state.update_grad())
+            {
+                return false;
+            }
+            else if (state.has_strong_wolfe(state0, c2()))
             {
                 return true;
             }
@@ -39,6 +48,7 @@ bool lsearchk_fletcher_t::zoom(const solver_state_t& state0,
                 hi = lo;
             }
             lo = state;
+            rejections = 0;
         }
     }
 
@@ -66,6 +76,7 @@ bool lsearchk_fletcher_t::get(const solver_state_t& state0, solver_state_t& stat
         }
 
         // next trial
+        // NB: the extrapolated trials are evaluated with the gradient, as they usually pass the Armijo condition
         const auto tmin = curr.t + 2 * (curr.t - prev.t);
         const auto tmax = curr.t + tau1() * (curr.t - prev.t);
         const auto next = lsearch_step_t::interpolate(prev, curr, m_interpolation);
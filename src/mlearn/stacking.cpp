@@ -21,6 +21,8 @@ namespace
         tensor1d_t  m_values;   ///<
         tensor4d_t  m_vgrads;   ///<
         tensor4d_t  m_outputs;  ///<
+        tensor4d_t  m_targets;  ///< buffer: gathered targets
+        tensor5d_t  m_models;   ///< buffer: gathered predictions with all models
     };
 }
 
@@ -47,9 +49,22 @@ vector_t stacking_function_t::as_weights(const vector_t& x)
 }
 
 scalar_t stacking_function_t::vgrad(const vector_t& x, vector_t* gx) const
+{
+    return evaluate(x, nullptr, gx);
+}
+
+scalar_t stacking_function_t::partial_vgrad(const vector_t& x, const indices_cmap_t& summands, vector_t* gx) const
+{
+    assert(summands.size() > 0);
+    assert(summands.min() >= 0 && summands.max() < m_outputs.size<1>());
+
+    return evaluate(x, &summands, gx);
+}
+
+scalar_t stacking_function_t::evaluate(const vector_t& x, const indices_cmap_t* summands, vector_t* gx) const
 {
     const auto models = m_outputs.size<0>();
-    const auto samples = m_outputs.size<1>();
+    const auto samples = (summands == nullptr) ? m_outputs.size<1>() : summands->size();
 
     assert(x.size() == models);
     assert(!gx || gx->size() == x.size());
@@ -63,39 +78,79 @@ scalar_t stacking_function_t::vgrad(const vector_t& x, vector_t* gx) const
     matrix_t gweights = -weights * weights.transpose();
     gweights.diagonal() += weights;
 
-    std::vector<cache_t> caches(tpool_t::size(), cache_t{models});
-    loopr(samples, static_cast<tensor_size_t>(batch()), [&] (tensor_size_t begin, tensor_size_t end, size_t tnum)
+    const auto accumulate = [&] (const tensor4d_t& targets, const tensor5d_t& moutputs, const tensor_range_t& range,
+        cache_t& cache)
     {
-        auto& cache = caches[tnum];
         auto& values = cache.m_values;
         auto& vgrads = cache.m_vgrads;
         auto& outputs = cache.m_outputs;
 
-        const auto range = make_range(begin, end);
-
         outputs.resize(make_dims(range.size(), m_outputs.size<2>(), m_outputs.size<3>(), m_outputs.size<4>()));
         outputs.zero();
         for (tensor_size_t model = 0; model < models; ++ model)
         {
-            outputs.vector() += weights(model) * m_outputs.tensor(model).slice(range).vector();
+            outputs.vector() += weights(model) * moutputs.tensor(model).slice(range).vector();
         }
 
-        m_loss.value(m_targets.slice(range), outputs.tensor(), values);
+        if (gx != nullptr)
+        {
+            m_loss.value_vgrad(targets.slice(range), outputs.tensor(), values, vgrads);
+        }
+        else
+        {
+            m_loss.value(targets.slice(range), outputs.tensor(), values);
+        }
         cache.m_fx += values.vector().sum();
 
         if (gx != nullptr)
         {
-            m_loss.vgrad(m_targets.slice(range), outputs.tensor(), vgrads);
-
             const auto gmatrix = vgrads.reshape(range.size(), -1).matrix();
 
             for (tensor_size_t model = 0; model < models; ++ model)
             {
-                const auto omatrix = m_outputs.tensor(model).slice(range).reshape(range.size(), - 1).matrix();
+                const auto omatrix = moutputs.tensor(model).slice(range).reshape(range.size(), - 1).matrix();
 
                 cache.m_gx += gweights.row(model) * (gmatrix.array() * omatrix.array()).colwise().sum().sum();
             }
         }
+    };
+
+    // NB: the (usually small) mini-batches of the stochastic solvers are split across all threads
+    const auto threads = static_cast<tensor_size_t>(tpool_t::size());
+    const auto chunk = (summands == nullptr) ? static_cast<tensor_size_t>(batch()) :
+        std::clamp((samples + threads - 1) / threads, tensor_size_t(1), static_cast<tensor_size_t>(batch()));
+
+    std::vector<cache_t> caches(tpool_t::size(), cache_t{models});
+    loopr(samples, chunk, [&] (tensor_size_t begin, tensor_size_t end, size_t tnum)
+    {
+        auto& cache = caches[tnum];
+
+        const auto range = make_range(begin, end);
+        if (summands == nullptr)
+        {
+            accumulate(m_targets, m_outputs, range, cache);
+        }
+        else
+        {
+            // NB: gather the targets and the predictions of the given subset of samples
+            const auto indices = summands->slice(range);
+
+            cache.m_targets.resize(make_dims(
+                range.size(), m_targets.size<1>(), m_targets.size<2>(), m_targets.size<3>()));
+            cache.m_models.resize(make_dims(
+                models, range.size(), m_outputs.size<2>(), m_outputs.size<3>(), m_outputs.size<4>()));
+
+            for (tensor_size_t i = 0; i < range.size(); ++ i)
+            {
+                cache.m_targets.vector(i) = m_targets.vector(indices(i));
+                for (tensor_size_t model = 0; model < models; ++ model)
+                {
+                    cache.m_models.vector(model, i) = m_outputs.vector(model, indices(i));
+                }
+            }
+
+            accumulate(cache.m_targets, cache.m_models, make_range(0, range.size()), cache);
+        }
     });
 
     for (size_t i = 1; i < caches.size(); ++ i)
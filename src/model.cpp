@@ -422,14 +422,19 @@ const model_param_t& model_t::find(const string_t& name) const
 
 tensor1d_t model_t::evaluate(const loss_t& loss, const dataset_t& dataset, const indices_t& samples) const
 {
-    const auto outputs = predict(dataset, samples);
-
     tensor1d_t errors(samples.size());
-    loopr(samples.size(), tensor_size_t{1024}, [&] (tensor_size_t begin, tensor_size_t end, size_t)
+    std::vector<tensor4d_t> outputs(tpool_t::size());
+
+    loopr(samples.size(), tensor_size_t{1024}, [&] (tensor_size_t begin, tensor_size_t end, size_t tnum)
     {
         const auto range = make_range(begin, end);
         const auto targets = dataset.targets(samples.slice(range));
-        loss.error(targets, outputs.slice(range), errors.slice(range));
+
+        auto& toutputs = outputs[tnum];
+        toutputs.resize(targets.dims());
+
+        predict(dataset, samples.slice(range), toutputs.tensor());
+        loss.error(targets, toutputs, errors.slice(range));
     });
 
     return errors;
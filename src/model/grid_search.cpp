@@ -187,3 +187,12 @@ tensor4d_t grid_search_model_t::predict(const dataset_t& dataset, const indices_
 
     return m_imodel.get().predict(dataset, samples);
 }
+
+void grid_search_model_t::predict(const dataset_t& dataset, const indices_cmap_t& samples, tensor4d_map_t outputs) const
+{
+    critical(
+        !m_imodel,
+        scat("grid-search model: invalid prototype model with id (", m_imodel.id(), ")!"));
+
+    m_imodel.get().predict(dataset, samples, std::move(outputs));
+}
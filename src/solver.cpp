@@ -1,8 +1,12 @@
 #include <mutex>
+#include <nano/tpool.h>
 #include <nano/solver/gd.h>
 #include <nano/solver/cgd.h>
 #include <nano/solver/lbfgs.h>
+#include <nano/solver/lbfgsb.h>
 #include <nano/solver/quasi.h>
+#include <nano/solver/newton.h>
+#include <nano/solver/stochastic.h>
 
 using namespace nano;
 
@@ -60,6 +64,32 @@ void solver_t::tolerance(const scalar_t c1, const scalar_t c2)
 }
 
 solver_state_t solver_t::minimize(const function_t& f, const vector_t& x0) const
+{
+    return minimize_one(f, x0, vector_t{}, vector_t{}, nullptr, 0);
+}
+
+solver_state_t solver_t::minimize(const function_t& f, const vector_t& x0,
+    const vector_t& lower, const vector_t& upper) const
+{
+    critical(
+        !bounded(),
+        "solver: bound constraints are not supported, use a bound-constrained solver (e.g. lbfgsb)!");
+
+    critical(
+        lower.size() != x0.size() || upper.size() != x0.size(),
+        scat("solver: invalid bounds, expecting ", x0.size(), " lower and upper bounds!"));
+
+    critical(
+        (lower.array() > upper.array()).any(),
+        "solver: invalid bounds, the lower bounds should not exceed the upper bounds!");
+
+    // NB: start from a feasible point
+    const vector_t x0p = x0.cwiseMax(lower).cwiseMin(upper);
+    return minimize_one(f, x0p, lower, upper, nullptr, 0);
+}
+
+solver_state_t solver_t::minimize_one(const function_t& f, const vector_t& x0,
+    const vector_t& lower, const vector_t& upper, std::atomic<bool>* stop, const scalar_t ftarget) const
 {
     assert(f.size() == x0.size());
 
@@ -74,9 +104,36 @@ solver_state_t solver_t::minimize(const function_t& f, const vector_t& x0) const
     auto function = solver_function_t{f};
     auto lsearch = lsearch_t{std::move(lsearch0), std::move(lsearchk)};
 
+    function.bounds(lower, upper);
+    function.stopping(stop, ftarget);
+
     return iterate(function, lsearch, x0);
 }
 
+std::vector<solver_state_t> solver_t::minimize_many(
+    const function_t& f, const std::vector<vector_t>& x0s, const scalar_t ftarget) const
+{
+    std::atomic<bool> stop{false};
+
+    std::vector<solver_state_t> states(x0s.size());
+    loopi(x0s.size(), [&] (const size_t i, const size_t)
+    {
+        if (stop.load())
+        {
+            // NB: the target was already reached by another minimization, so skip this one
+            states[i] = solver_state_t{f, x0s[i]};
+            states[i].m_status = solver_state_t::status::stopped;
+        }
+        else
+        {
+            states[i] = minimize_one(f, x0s[i], vector_t{}, vector_t{}, &stop, ftarget);
+        }
+    });
+
+    std::stable_sort(states.begin(), states.end());
+    return states;
+}
+
 void solver_t::logger(const logger_t& logger)
 {
     m_logger = logger;
@@ -93,12 +150,24 @@ void solver_t::max_iterations(const int max_iterations)
 }
 
 bool solver_t::done(const solver_function_t& function, solver_state_t& state, const bool iter_ok) const
+{
+    return done(function, state, iter_ok, state.converged(epsilon()));
+}
+
+bool solver_t::done(const solver_function_t& function, solver_state_t& state, const bool iter_ok,
+    const bool converged) const
 {
     state.m_fcalls = function.fcalls();
     state.m_gcalls = function.gcalls();
+    state.m_hcalls = function.hcalls();
+    state.m_pcalls = function.pcalls();
+    state.m_hits = function.hits();
+    state.m_misses = function.misses();
+    state.m_time = function.elapsed();
+    state.m_ftime = function.ftime();
+    state.m_fbytes = function.fbytes();
 
     const auto step_ok = iter_ok && state;
-    const auto converged = state.converged(epsilon());
 
     if (converged || !step_ok)
     {
@@ -109,6 +178,13 @@ bool solver_t::done(const solver_function_t& function, solver_state_t& state, co
         log(state);
         return true;
     }
+    else if (function.stopped(state.f))
+    {
+        // the target function value was reached (possibly by a concurrent minimization)
+        state.m_status = solver_state_t::status::stopped;
+        log(state);
+        return true;
+    }
     else if (!log(state))
     {
         // stopping was requested
@@ -147,11 +223,16 @@ solver_factory_t& solver_t::all()
         manager.add<solver_cgd_dyhs_t>("cgd-dyhs", "conjugate gradient descent (DYHS)");
         manager.add<solver_cgd_frpr_t>("cgd-prfr", "conjugate gradient descent (FRPR)");
         manager.add<solver_lbfgs_t>("lbfgs", "limited-memory BFGS");
+        manager.add<solver_lbfgsb_t>("lbfgsb", "limited-memory BFGS with box constraints (L-BFGS-B)");
         manager.add<solver_quasi_dfp_t>("dfp", "quasi-newton method (DFP)");
         manager.add<solver_quasi_sr1_t>("sr1", "quasi-newton method (SR1)");
         manager.add<solver_quasi_bfgs_t>("bfgs", "quasi-newton method (BFGS)");
         manager.add<solver_quasi_hoshino_t>("hoshino", "quasi-newton method (Hoshino formula)");
         manager.add<solver_quasi_fletcher_t>("fletcher", "quasi-newton method (Fletcher's switch)");
+        manager.add<solver_newton_t>("newton", "truncated Newton method (Newton-CG)");
+        manager.add<solver_sgd_t>("sgd", "stochastic gradient descent with momentum");
+        manager.add<solver_adam_t>("adam", "stochastic adaptive moment estimation (Adam)");
+        manager.add<solver_svrg_t>("svrg", "stochastic variance reduced gradient (SVRG)");
     });
 
     return manager;
@@ -1,4 +1,3 @@
-#include <deque>
 #include <nano/solver/lbfgs.h>
 
 using namespace nano;
@@ -17,49 +16,113 @@ solver_state_t solver_lbfgs_t::iterate(const solver_function_t& function, const
         return cstate;
     }
 
-    vector_t q, r;
-    solver_state_t pstate;
-    std::deque<vector_t> ss, ys;
+    const auto m = static_cast<tensor_size_t>(history());
+    const auto n = x0.size();
 
-    for (int64_t i = 0; i < max_iterations(); ++ i)
+    // history of updates stored as a ring buffer: the next update is written at the <head> row
+    matrix_t S(m, n), Y(m, n);
+    vector_t rho(m), alpha(m);
+    tensor_size_t head = 0, count = 0;
+
+    // NB: the inner products between the updates are cached for the compact representation (in ring buffer order)
+    const auto compact = repr() == representation::compact;
+    matrix_t SY, YY, R, M;
+    vector_t a, b, u, v;
+    if (compact)
     {
-        // descent direction
-        //      (see "Numerical optimization", Nocedal & Wright, 2nd edition, p.178)
-        q = cstate.g;
+        SY.resize(m, m);
+        YY.resize(m, m);
+        R.resize(m, m);
+        M.resize(m, m);
+        a.resize(m);
+        b.resize(m);
+        u.resize(m);
+        v.resize(m);
+    }
 
-        const auto hsize = ss.size();
+    const auto slot = [&] (tensor_size_t j)
+    {
+        // the j-th oldest update in the ring buffer
+        return (head - count + j + m) % m;
+    };
 
-        std::vector<scalar_t> alphas(hsize);
-        for (size_t j = 0; j < hsize; ++ j)
-        {
-            const auto& s = ss[hsize - 1 - j];
-            const auto& y = ys[hsize - 1 - j];
+    vector_t q(n), r(n);
+    solver_state_t pstate = cstate;
 
-            const scalar_t alpha = s.dot(q) / s.dot(y);
-            q.noalias() -= alpha * y;
-            alphas[j] = alpha;
-        }
-
-        if (ss.empty())
+    for (int64_t i = 0; i < max_iterations(); ++ i)
+    {
+        // descent direction
+        if (count == 0)
         {
-            r = q;
+            r = cstate.g;
         }
-        else
+        else if (!compact)
         {
-            const auto& s = ss[hsize - 1];
-            const auto& y = ys[hsize - 1];
+            // two-loop recursion
+            //      (see "Numerical optimization", Nocedal & Wright, 2nd edition, p.178)
+            q = cstate.g;
+            for (auto j = count - 1; j >= 0; -- j)
+            {
+                const auto k = slot(j);
+                alpha(k) = rho(k) * S.row(k).dot(q);
+                q.noalias() -= alpha(k) * Y.row(k).transpose();
+            }
 
-            r = s.dot(y) / y.dot(y) * q;
-        }
+            const auto kk = slot(count - 1);
+            r = q / (rho(kk) * Y.row(kk).squaredNorm());
 
-        for (size_t j = 0; j < hsize; ++ j)
+            for (tensor_size_t j = 0; j < count; ++ j)
+            {
+                const auto k = slot(j);
+                const auto beta = rho(k) * Y.row(k).dot(r);
+                r.noalias() += (alpha(k) - beta) * S.row(k).transpose();
+            }
+        }
+        else
         {
-            const auto& s = ss[j];
-            const auto& y = ys[j];
+            // compact representation of the inverse Hessian approximation
+            //      (see "Representations of quasi-Newton matrices...", Byrd, Nocedal & Schnabel, 1994, p.15):
+            //  H = g * I + [S g*Y] * [R^-T * (D + g * Y^T * Y) * R^-1, -R^-T; -R^-1, 0] * [S^T; g*Y^T]
+            const auto kk = slot(count - 1);
+            const auto gamma = 1.0 / (rho(kk) * YY(kk, kk));
+
+            auto ac = a.head(count), bc = b.head(count), uc = u.head(count), vc = v.head(count);
+            auto Rc = R.topLeftCorner(count, count), Mc = M.topLeftCorner(count, count);
+
+            // NB: the rows of the history matrices are ordered by the ring buffer, so permute the results
+            //  (in chronological order) to form the triangular matrix R
+            v.head(count).noalias() = S.topRows(count) * cstate.g;
+            u.head(count).noalias() = Y.topRows(count) * cstate.g;
+            for (tensor_size_t j = 0; j < count; ++ j)
+            {
+                const auto kj = slot(j);
+                ac(j) = v(kj);
+                bc(j) = u(kj);
+                for (tensor_size_t l = 0; l < count; ++ l)
+                {
+                    const auto kl = slot(l);
+                    Rc(j, l) = (j <= l) ? SY(kj, kl) : scalar_t(0);
+                    Mc(j, l) = gamma * YY(kj, kl);
+                }
+                Mc(j, j) += SY(kj, kj);
+            }
+
+            // u = R^-1 * S^T * g, v = R^-T * ((D + g * Y^T * Y) * u - g * Y^T * g)
+            uc = ac;
+            Rc.triangularView<Eigen::Upper>().solveInPlace(uc);
+            vc.noalias() = Mc * uc;
+            vc -= gamma * bc;
+            Rc.transpose().triangularView<Eigen::Lower>().solveInPlace(vc);
 
-            const scalar_t alpha = alphas[hsize - 1 - j];
-            const scalar_t beta = y.dot(r) / s.dot(y);
-            r.noalias() += s * (alpha - beta);
+            // r = g * g + S * v - g * Y * u
+            r = gamma * cstate.g;
+            for (tensor_size_t j = 0; j < count; ++ j)
+            {
+                a(slot(j)) = vc(j);
+                b(slot(j)) = -gamma * uc(j);
+            }
+            r.noalias() += S.topRows(count).transpose() * a.head(count);
+            r.noalias() += Y.topRows(count).transpose() * b.head(count);
         }
 
         cstate.d = -r;
@@ -83,18 +146,23 @@ solver_state_t solver_lbfgs_t::iterate(const solver_function_t& function, const
         //      "A Multi-Batch L-BFGS Method for Machine Learning", page 6 - the non-convex case
         if (has_descent)
         {
-            ss.emplace_back(cstate.x - pstate.x);
-            ys.emplace_back(cstate.g - pstate.g);
-            if (ss.size() > history())
+            S.row(head) = (cstate.x - pstate.x).transpose();
+            Y.row(head) = (cstate.g - pstate.g).transpose();
+            rho(head) = 1.0 / S.row(head).dot(Y.row(head));
+
+            count = std::min(count + 1, m);
+            if (compact)
             {
-                ss.pop_front();
-                ys.pop_front();
+                SY.col(head).head(count).noalias() = S.topRows(count) * Y.row(head).transpose();
+                SY.row(head).head(count).noalias() = S.row(head) * Y.topRows(count).transpose();
+                YY.col(head).head(count).noalias() = Y.topRows(count) * Y.row(head).transpose();
+                YY.row(head).head(count) = YY.col(head).head(count).transpose();
             }
+            head = (head + 1) % m;
         }
         else
         {
-            ss.clear();
-            ys.clear();
+            head = count = 0;
         }
     }
 
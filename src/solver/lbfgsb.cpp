@@ -0,0 +1,339 @@
+#include <Eigen/LU>
+#include <nano/numeric.h>
+#include <nano/solver/lbfgsb.h>
+
+using namespace nano;
+
+solver_lbfgsb_t::solver_lbfgsb_t() :
+    solver_t(1e-4, 9e-1, "constant", "backtrack")
+{
+}
+
+solver_state_t solver_lbfgsb_t::iterate(const solver_function_t& function, const lsearch_t& lsearch, const vector_t& x0) const
+{
+    const auto n = x0.size();
+    const auto m = static_cast<tensor_size_t>(history());
+
+    // NB: no bounds means an unconstrained problem
+    const vector_t lower = function.lower().size() == n ?
+        function.lower() : vector_t::Constant(n, -std::numeric_limits<scalar_t>::infinity());
+    const vector_t upper = function.upper().size() == n ?
+        function.upper() : vector_t::Constant(n, +std::numeric_limits<scalar_t>::infinity());
+
+    const auto project = [&] (const vector_t& x) -> vector_t
+    {
+        return x.cwiseMax(lower).cwiseMin(upper);
+    };
+
+    vector_t pg(n);
+    const auto converged = [&] (const solver_state_t& state)
+    {
+        // NB: the projected gradient is zero at a critical point of the bound-constrained problem
+        pg = (state.x - state.g).cwiseMax(lower).cwiseMin(upper) - state.x;
+        return pg.lpNorm<Eigen::Infinity>() / std::max(scalar_t(1), std::fabs(state.f)) < epsilon();
+    };
+
+    auto cstate = solver_state_t{function, project(x0)};
+    if (solver_t::done(function, cstate, true, converged(cstate)))
+    {
+        return cstate;
+    }
+
+    // history of updates in chronological order (the oldest update is dropped when full)
+    //  and the inner products between the updates
+    matrix_t S(m, n), Y(m, n), SS(m, m), SY(m, m), YY(m, m);
+    tensor_size_t count = 0;
+    scalar_t theta = 1;
+
+    // compact representation of the limited memory BFGS approximation of the Hessian
+    //      (see "Representations of quasi-Newton matrices...", Byrd, Nocedal & Schnabel, 1994, p.10):
+    //  B = theta * I - W * M * W^T, where W = [Y theta*S] and M = [-D L^T; L theta*S^T*S]^-1
+    matrix_t Minv(2 * m, 2 * m), K(2 * m, 2 * m);
+    Eigen::PartialPivLU<matrix_t> Mlu, Klu;
+
+    const auto Wt_times = [&] (const vector_t& x, vector_t& Wtx)
+    {
+        Wtx.resize(2 * count);
+        Wtx.head(count).noalias() = Y.topRows(count) * x;
+        Wtx.tail(count).noalias() = theta * S.topRows(count) * x;
+    };
+
+    const auto W_times = [&] (const vector_t& x, vector_t& Wx)
+    {
+        Wx.noalias() = Y.topRows(count).transpose() * x.head(count);
+        Wx.noalias() += theta * S.topRows(count).transpose() * x.tail(count);
+    };
+
+    const auto W_row = [&] (const tensor_size_t j, vector_t& wj)
+    {
+        wj.resize(2 * count);
+        wj.head(count) = Y.col(j).head(count);
+        wj.tail(count) = theta * S.col(j).head(count);
+    };
+
+    const auto M_times = [&] (const vector_t& x, vector_t& Mx)
+    {
+        if (count == 0)
+        {
+            Mx.resize(0);
+        }
+        else
+        {
+            Mx = Mlu.solve(x);
+        }
+    };
+
+    vector_t tb(n), dc(n), xcp(n), r(n), du(n), Wx(n), s(n), y(n);
+    vector_t p, c, wb, Mp, Mc, Mw, v;
+    std::vector<tensor_size_t> breakpoints, active;
+    breakpoints.reserve(static_cast<size_t>(n));
+    active.reserve(static_cast<size_t>(n));
+
+    solver_state_t pstate = cstate;
+
+    for (int64_t i = 0; i < max_iterations(); ++ i)
+    {
+        const auto& x = cstate.x;
+        const auto& g = cstate.g;
+
+        // generalized Cauchy point: the first local minimizer of the quadratic model
+        //  along the projected gradient path x(t) = P(x - t * g)
+        //      (see "A limited memory algorithm for bound constrained optimization", Byrd et al., 1995, p.7)
+        breakpoints.clear();
+        for (tensor_size_t j = 0; j < n; ++ j)
+        {
+            tb(j) =
+                (g(j) < 0) ? (x(j) - upper(j)) / g(j) :
+                (g(j) > 0) ? (x(j) - lower(j)) / g(j) :
+                std::numeric_limits<scalar_t>::infinity();
+            dc(j) = (tb(j) > 0) ? -g(j) : scalar_t(0);
+            if (tb(j) > 0 && std::isfinite(tb(j)))
+            {
+                breakpoints.push_back(j);
+            }
+        }
+        std::sort(breakpoints.begin(), breakpoints.end(), [&] (tensor_size_t j1, tensor_size_t j2)
+        {
+            return tb(j1) < tb(j2);
+        });
+
+        Wt_times(dc, p);
+        c = vector_t::Zero(2 * count);
+        M_times(p, Mp);
+
+        auto fp = -dc.squaredNorm();
+        auto fpp = -theta * fp - p.dot(Mp);
+        const auto fpp0 = fpp;
+
+        const auto min_step = [&] ()
+        {
+            return (fp >= 0) ? scalar_t(0) : -fp / std::max(fpp, epsilon0<scalar_t>() * fpp0);
+        };
+
+        auto dt_min = min_step();
+        auto t_old = scalar_t(0);
+
+        xcp = x;
+        for (const auto b : breakpoints)
+        {
+            const auto dt = tb(b) - t_old;
+            if (dt_min < dt)
+            {
+                break;
+            }
+
+            // the b-th variable hits its bound, so fix it and update the derivatives along the path
+            xcp(b) = (dc(b) > 0) ? upper(b) : lower(b);
+
+            const auto gb = g(b);
+            const auto zb = xcp(b) - x(b);
+
+            c.noalias() += dt * p;
+            W_row(b, wb);
+            M_times(c, Mc);
+            M_times(p, Mp);
+            M_times(wb, Mw);
+
+            fp += dt * fpp + gb * gb + theta * gb * zb - gb * wb.dot(Mc);
+            fpp -= theta * gb * gb + 2 * gb * wb.dot(Mp) + gb * gb * wb.dot(Mw);
+
+            p.noalias() += gb * wb;
+            dc(b) = 0;
+            dt_min = min_step();
+            t_old = tb(b);
+        }
+
+        dt_min = std::isfinite(dt_min) ? std::max(dt_min, scalar_t(0)) : scalar_t(0);
+        t_old += dt_min;
+        for (tensor_size_t j = 0; j < n; ++ j)
+        {
+            if (dc(j) != 0)
+            {
+                xcp(j) = x(j) + t_old * dc(j);
+            }
+        }
+        c.noalias() += dt_min * p;
+
+        // subspace minimization of the quadratic model over the free variables at the Cauchy point
+        //  (direct primal method) using the Sherman-Morrison-Woodbury formula with the compact representation:
+        //  du = -1/theta * r - 1/theta^2 * Wz * (M^-1 - 1/theta * Wz^T * Wz)^-1 * Wz^T * r
+        active.clear();
+        for (tensor_size_t j = 0; j < n; ++ j)
+        {
+            if (xcp(j) <= lower(j) || xcp(j) >= upper(j))
+            {
+                active.push_back(j);
+            }
+        }
+
+        r = g + theta * (xcp - x);
+        if (count > 0)
+        {
+            M_times(c, Mc);
+            W_times(Mc, Wx);
+            r -= Wx;
+        }
+        for (const auto j : active)
+        {
+            r(j) = 0;
+        }
+
+        du = -r / theta;
+        if (count > 0)
+        {
+            // NB: Wz^T * Wz = W^T * W - the outer products of the rows of W of the active variables
+            auto Kk = K.topLeftCorner(2 * count, 2 * count);
+            Kk = Minv.topLeftCorner(2 * count, 2 * count);
+            Kk.topLeftCorner(count, count) -= YY.topLeftCorner(count, count) / theta;
+            Kk.topRightCorner(count, count) -= SY.topLeftCorner(count, count).transpose();
+            Kk.bottomLeftCorner(count, count) -= SY.topLeftCorner(count, count);
+            Kk.bottomRightCorner(count, count) -= theta * SS.topLeftCorner(count, count);
+            for (const auto j : active)
+            {
+                W_row(j, wb);
+                Kk.noalias() += wb * wb.transpose() / theta;
+            }
+
+            Klu.compute(Kk);
+            Wt_times(r, v);
+            v = Klu.solve(v);
+            W_times(v, Wx);
+            du -= Wx / (theta * theta);
+            for (const auto j : active)
+            {
+                du(j) = 0;
+            }
+        }
+
+        // truncate the step to stay feasible
+        auto alpha = scalar_t(1);
+        for (tensor_size_t j = 0; j < n; ++ j)
+        {
+            if (du(j) > 0)
+            {
+                alpha = std::min(alpha, (upper(j) - xcp(j)) / du(j));
+            }
+            else if (du(j) < 0)
+            {
+                alpha = std::min(alpha, (lower(j) - xcp(j)) / du(j));
+            }
+        }
+
+        cstate.d = xcp + alpha * du - x;
+
+        // Force descent direction
+        if (!cstate.has_descent())
+        {
+            cstate.d = pg;
+        }
+
+        // NB: the first step (without history) is scaled to unit length
+        //  as the gradient may be arbitrarily large (e.g. away from the minimum).
+        if (count == 0)
+        {
+            cstate.d /= std::max(scalar_t(1), cstate.d.norm());
+        }
+
+        // line-search
+        pstate = cstate;
+        auto iter_ok = lsearch.get(cstate);
+
+        // NB: the points beyond the unit step length may be infeasible
+        if (iter_ok && cstate.t > 1)
+        {
+            iter_ok = cstate.update(pstate, 1);
+        }
+        if (iter_ok && (cstate.x.array() < lower.array() || cstate.x.array() > upper.array()).any())
+        {
+            iter_ok = cstate.update(project(cstate.x));
+        }
+
+        if (solver_t::done(function, cstate, iter_ok, converged(cstate)))
+        {
+            break;
+        }
+
+        // Skip the update if the curvature condition is not satisfied
+        //      (see "A limited memory algorithm for bound constrained optimization", Byrd et al., 1995, p.17)
+        s = cstate.x - pstate.x;
+        y = cstate.g - pstate.g;
+        const auto sy = s.dot(y), yy = y.squaredNorm();
+        if (!(sy > epsilon0<scalar_t>() * yy))
+        {
+            // NB: restart with the (scaled) projected gradient if no progress is made
+            if (s.lpNorm<Eigen::Infinity>() == 0)
+            {
+                count = 0;
+            }
+            continue;
+        }
+
+        // drop the oldest update if the history is full
+        if (count == m)
+        {
+            for (tensor_size_t j = 0; j + 1 < m; ++ j)
+            {
+                S.row(j) = S.row(j + 1);
+                Y.row(j) = Y.row(j + 1);
+                for (tensor_size_t l = 0; l + 1 < m; ++ l)
+                {
+                    SS(j, l) = SS(j + 1, l + 1);
+                    SY(j, l) = SY(j + 1, l + 1);
+                    YY(j, l) = YY(j + 1, l + 1);
+                }
+            }
+            -- count;
+        }
+
+        const auto k = count ++;
+        S.row(k) = s.transpose();
+        Y.row(k) = y.transpose();
+
+        SS.col(k).head(count).noalias() = S.topRows(count) * s;
+        SS.row(k).head(count) = SS.col(k).head(count).transpose();
+        YY.col(k).head(count).noalias() = Y.topRows(count) * y;
+        YY.row(k).head(count) = YY.col(k).head(count).transpose();
+        SY.row(k).head(count).noalias() = (Y.topRows(count) * s).transpose();
+        SY.col(k).head(count).noalias() = S.topRows(count) * y;
+
+        theta = yy / sy;
+
+        // update the middle matrix of the compact representation (in factorized form)
+        auto Mk = Minv.topLeftCorner(2 * count, 2 * count);
+        Mk.setZero();
+        for (tensor_size_t j = 0; j < count; ++ j)
+        {
+            Mk(j, j) = -SY(j, j);
+            for (tensor_size_t l = 0; l < j; ++ l)
+            {
+                // L(j, l) = s_j^T * y_l for j > l
+                Mk(count + j, l) = SY(j, l);
+                Mk(l, count + j) = SY(j, l);
+            }
+        }
+        Mk.bottomRightCorner(count, count) = theta * SS.topLeftCorner(count, count);
+        Mlu.compute(Mk);
+    }
+
+    return cstate;
+}
@@ -0,0 +1,82 @@
+#include <nano/solver/newton.h>
+
+using namespace nano;
+
+solver_newton_t::solver_newton_t() :
+    solver_t(1e-4, 9e-1, "constant", "morethuente")
+{
+}
+
+solver_state_t solver_newton_t::iterate(const solver_function_t& function, const lsearch_t& lsearch, const vector_t& x0) const
+{
+    auto cstate = solver_state_t{function, x0};
+    if (solver_t::done(function, cstate, true))
+    {
+        return cstate;
+    }
+
+    const auto n = x0.size();
+    const auto max_cgiters = static_cast<int64_t>(cgiters());
+
+    vector_t z(n), r(n), d(n), Hd(n);
+
+    for (int64_t i = 0; i < max_iterations(); ++ i)
+    {
+        // approximately solve the Newton system H * z = -g with conjugate gradient
+        //      (see "Numerical optimization", Nocedal & Wright, 2nd edition, p.169)
+        const auto gnorm = cstate.g.norm();
+        const auto tolerance = std::min(forcing(), std::sqrt(gnorm)) * gnorm;
+
+        z.setZero();
+        r = cstate.g;
+        d = -r;
+
+        auto rr = r.squaredNorm();
+        for (int64_t j = 0; j < max_cgiters; ++ j)
+        {
+            function.hvp(cstate.x, d, Hd);
+
+            // stop at the first direction of non-positive curvature
+            const auto dHd = d.dot(Hd);
+            if (dHd <= 0 || !std::isfinite(dHd))
+            {
+                if (j == 0)
+                {
+                    z = -cstate.g;
+                }
+                break;
+            }
+
+            const auto alpha = rr / dHd;
+            z.noalias() += alpha * d;
+            r.noalias() += alpha * Hd;
+
+            const auto rr1 = r.squaredNorm();
+            if (std::sqrt(rr1) < tolerance)
+            {
+                break;
+            }
+
+            const auto beta = rr1 / rr;
+            d = -r + beta * d;
+            rr = rr1;
+        }
+
+        cstate.d = z;
+
+        // Force descent direction
+        if (!cstate.has_descent())
+        {
+            cstate.d = -cstate.g;
+        }
+
+        // line-search
+        const auto iter_ok = lsearch.get(cstate);
+        if (solver_t::done(function, cstate, iter_ok))
+        {
+            break;
+        }
+    }
+
+    return cstate;
+}
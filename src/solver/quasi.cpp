@@ -1,67 +1,115 @@
+#include <tuple>
 #include <nano/solver/quasi.h>
 
 using namespace nano;
 
 namespace
 {
-    template <typename tvector>
-    auto SR1(const matrix_t& H, const tvector& dx, const tvector& dg)
+    ///
+    /// \brief in-place symmetric update: H += a * dx * dx^T + b * (dx * h^T + h * dx^T) + c * h * h^T.
+    ///
+    /// NB: all quasi-Newton updates below can be written in this form with h = H * dg,
+    ///     so that they require O(n^2) operations and no n x n temporaries.
+    ///
+    void update(matrix_t& H, const vector_t& dx, const vector_t& h, const scalar_t a, const scalar_t b, const scalar_t c)
     {
-        return  H + (dx - H * dg) * (dx - H * dg).transpose() / (dx - H * dg).dot(dg);
+        H.noalias() += (a * dx + b * h) * dx.transpose();
+        H.noalias() += (b * dx + c * h) * h.transpose();
     }
 
-    template <typename tvector>
-    void SR1(matrix_t& H, const tvector& dx, const tvector& dg, const scalar_t r)
+    ///
+    /// \brief the quantities shared by the quasi-Newton updates (computed once per update).
+    ///
+    struct quasi_t
     {
-        const auto denom = (dx - H * dg).dot(dg);
-        const auto apply = std::fabs(denom) >= r * dx.norm() * (dx - H * dg).norm();
+        quasi_t(const matrix_t& H, const solver_state_t& prev, const solver_state_t& curr) :
+            dx(curr.x - prev.x),
+            dg(curr.g - prev.g),
+            h(H * dg),
+            dxdg(dx.dot(dg)),
+            dghdg(dg.dot(h))
+        {
+        }
+
+        vector_t    dx;     ///< x_k+1 - x_k
+        vector_t    dg;     ///< g_k+1 - g_k
+        vector_t    h;      ///< H * dg
+        scalar_t    dxdg;   ///< dx^T * dg
+        scalar_t    dghdg;  ///< dg^T * H * dg
+    };
+
+    void SR1(matrix_t& H, const quasi_t& q)
+    {
+        // H += (dx - h) * (dx - h)^T / (dx - h)^T * dg
+        const auto denom = q.dxdg - q.dghdg;
+
+        update(H, q.dx, q.h, +1 / denom, -1 / denom, +1 / denom);
+    }
+
+    void SR1(matrix_t& H, const quasi_t& q, const scalar_t r)
+    {
+        const auto denom = q.dxdg - q.dghdg;
+        const auto apply = std::fabs(denom) >= r * q.dx.norm() * (q.dx - q.h).norm();
 
         if (apply)
         {
-            H = SR1(H, dx, dg);
+            SR1(H, q);
         }
     }
 
-    template <typename tvector>
-    auto DFP(const matrix_t& H, const tvector& dx, const tvector& dg)
+    auto DFP(const quasi_t& q)
+    {
+        // H += dx * dx^T / dx^T * dg - h * h^T / dg^T * h
+        return std::make_tuple(1 / q.dxdg, scalar_t(0), -1 / q.dghdg);
+    }
+
+    auto BFGS(const quasi_t& q)
     {
-        return  H + (dx * dx.transpose()) / dx.dot(dg) -
-                (H * dg * dg.transpose() * H) / (dg.transpose() * H * dg);
+        // H = (I - rho * dx * dg^T) * H * (I - rho * dg * dx^T) + rho * dx * dx^T, where rho = 1 / dx^T * dg
+        //   = H - rho * (dx * h^T + h * dx^T) + (rho + rho^2 * dg^T * h) * dx * dx^T
+        const auto rho = 1 / q.dxdg;
+
+        return std::make_tuple(rho + rho * rho * q.dghdg, -rho, scalar_t(0));
     }
 
-    template <typename tvector>
-    auto BFGS(const matrix_t& H, const tvector& dx, const tvector& dg)
+    void DFP(matrix_t& H, const quasi_t& q)
     {
-        const auto I = matrix_t::Identity(H.rows(), H.cols());
+        const auto [a, b, c] = DFP(q);
+        update(H, q.dx, q.h, a, b, c);
+    }
 
-        return  (I - dx * dg.transpose() / dx.dot(dg)) * H * (I - dg * dx.transpose() / dx.dot(dg)) +
-                dx * dx.transpose() / dx.dot(dg);
+    void BFGS(matrix_t& H, const quasi_t& q)
+    {
+        const auto [a, b, c] = BFGS(q);
+        update(H, q.dx, q.h, a, b, c);
     }
 
-    template <typename tvector>
-    auto HOSHINO(const matrix_t& H, const tvector& dx, const tvector& dg)
+    void HOSHINO(matrix_t& H, const quasi_t& q)
     {
-        const auto phi = dx.dot(dg) / (dx.dot(dg) + dg.transpose() * H * dg);
+        // H = (1 - phi) * DFP(H) + phi * BFGS(H)
+        const auto phi = q.dxdg / (q.dxdg + q.dghdg);
+
+        const auto [a1, b1, c1] = DFP(q);
+        const auto [a2, b2, c2] = BFGS(q);
 
-        return  (1 - phi) * DFP(H, dx, dg) + phi * BFGS(H, dx, dg);
+        update(H, q.dx, q.h, (1 - phi) * a1 + phi * a2, (1 - phi) * b1 + phi * b2, (1 - phi) * c1 + phi * c2);
     }
 
-    template <typename tvector>
-    void FLETCHER(matrix_t& H, const tvector& dx, const tvector& dg)
+    void FLETCHER(matrix_t& H, const quasi_t& q)
     {
-        const auto phi = dx.dot(dg) / (dx.dot(dg) - dg.transpose() * H * dg);
+        const auto phi = q.dxdg / (q.dxdg - q.dghdg);
 
         if (phi < scalar_t(0))
         {
-            H = DFP(H, dx, dg);
+            DFP(H, q);
         }
         else if (phi > scalar_t(1))
         {
-            H = BFGS(H, dx, dg);
+            BFGS(H, q);
         }
         else
         {
-            H = SR1(H, dx, dg);
+            SR1(H, q);
         }
     }
 }
@@ -114,7 +162,8 @@ solver_state_t solver_quasi_t::iterate(const solver_function_t& function, const
                 {
                     const auto dx = cstate.x - pstate.x;
                     const auto dg = cstate.g - pstate.g;
-                    H = matrix_t::Identity(H.rows(), H.cols()) * dx.dot(dg) / dg.dot(dg);
+                    H.setIdentity();
+                    H.diagonal().array() = dx.dot(dg) / dg.dot(dg);
                 }
                 break;
 
@@ -132,25 +181,25 @@ solver_state_t solver_quasi_t::iterate(const solver_function_t& function, const
 
 void solver_quasi_sr1_t::update(const solver_state_t& prev, const solver_state_t& curr, matrix_t& H) const
 {
-    ::SR1(H, curr.x - prev.x, curr.g - prev.g, r());
+    ::SR1(H, quasi_t{H, prev, curr}, r());
 }
 
 void solver_quasi_dfp_t::update(const solver_state_t& prev, const solver_state_t& curr, matrix_t& H) const
 {
-    H = ::DFP(H, curr.x - prev.x, curr.g - prev.g);
+    ::DFP(H, quasi_t{H, prev, curr});
 }
 
 void solver_quasi_bfgs_t::update(const solver_state_t& prev, const solver_state_t& curr, matrix_t& H) const
 {
-    H = ::BFGS(H, curr.x - prev.x, curr.g - prev.g);
+    ::BFGS(H, quasi_t{H, prev, curr});
 }
 
 void solver_quasi_hoshino_t::update(const solver_state_t& prev, const solver_state_t& curr, matrix_t& H) const
 {
-    H = ::HOSHINO(H, curr.x - prev.x, curr.g - prev.g);
+    ::HOSHINO(H, quasi_t{H, prev, curr});
 }
 
 void solver_quasi_fletcher_t::update(const solver_state_t& prev, const solver_state_t& curr, matrix_t& H) const
 {
-    ::FLETCHER(H, curr.x - prev.x, curr.g - prev.g);
+    ::FLETCHER(H, quasi_t{H, prev, curr});
 }
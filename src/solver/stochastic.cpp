@@ -0,0 +1,65 @@
+#include <nano/numeric.h>
+#include <nano/solver/stochastic.h>
+
+using namespace nano;
+
+solver_stochastic_t::solver_stochastic_t() = default;
+
+solver_sgd_t::solver_sgd_t() = default;
+
+solver_state_t solver_sgd_t::iterate(const solver_function_t& function, const lsearch_t&, const vector_t& x0) const
+{
+    vector_t gx(x0.size());
+    vector_t vx = vector_t::Zero(x0.size());
+
+    return loop(function, x0, [&] (const solver_state_t&, const indices_cmap_t& samples, vector_t& x)
+    {
+        function.partial_vgrad(x, samples, &gx);
+
+        vx = momentum() * vx - lrate() * gx;
+        x += vx;
+    });
+}
+
+solver_adam_t::solver_adam_t() = default;
+
+solver_state_t solver_adam_t::iterate(const solver_function_t& function, const lsearch_t&, const vector_t& x0) const
+{
+    vector_t gx(x0.size());
+    vector_t m1 = vector_t::Zero(x0.size());
+    vector_t m2 = vector_t::Zero(x0.size());
+
+    const auto beta1 = this->beta1();
+    const auto beta2 = this->beta2();
+    const auto delta = epsilon0<scalar_t>();
+
+    scalar_t beta1t = 1, beta2t = 1;
+    return loop(function, x0, [&] (const solver_state_t&, const indices_cmap_t& samples, vector_t& x)
+    {
+        function.partial_vgrad(x, samples, &gx);
+
+        m1 = beta1 * m1 + (1 - beta1) * gx;
+        m2 = beta2 * m2 + (1 - beta2) * gx.array().square().matrix();
+
+        beta1t *= beta1;
+        beta2t *= beta2;
+
+        x.array() -= lrate() * (m1.array() / (1 - beta1t)) / ((m2.array() / (1 - beta2t)).sqrt() + delta);
+    });
+}
+
+solver_svrg_t::solver_svrg_t() = default;
+
+solver_state_t solver_svrg_t::iterate(const solver_function_t& function, const lsearch_t&, const vector_t& x0) const
+{
+    vector_t gx(x0.size());
+    vector_t g0(x0.size());
+
+    return loop(function, x0, [&] (const solver_state_t& snapshot, const indices_cmap_t& samples, vector_t& x)
+    {
+        function.partial_vgrad(x, samples, &gx);
+        function.partial_vgrad(snapshot.x, samples, &g0);
+
+        x -= lrate() * (gx - g0 + snapshot.g);
+    });
+}
@@ -1,3 +1,4 @@
+#include <tuple>
 #include <nano/logger.h>
 #include <nano/stream.h>
 #include <nano/tensor/stream.h>
@@ -22,6 +23,13 @@ void serializable_t::read(std::istream& stream)
         "serializable: version mismatch!");
 }
 
+bool serializable_t::serialized_since(int32_t major_version, int32_t minor_version, int32_t patch_version) const
+{
+    return
+        std::make_tuple(m_major_version, m_minor_version, m_patch_version) >=
+        std::make_tuple(major_version, minor_version, patch_version);
+}
+
 void serializable_t::write(std::ostream& stream) const
 {
     critical(
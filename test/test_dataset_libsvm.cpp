@@ -0,0 +1,220 @@
+#include <fstream>
+#include <utest/utest.h>
+#include <nano/mlearn/class.h>
+#include <nano/dataset/libsvm.h>
+
+using namespace nano;
+
+static auto data_path() { return "test_dataset_libsvm_data.txt"; }
+
+static void write_data(const char* data)
+{
+    std::ofstream os(data_path());
+    os << data;
+    UTEST_REQUIRE(os);
+}
+
+static auto load_data(const char* data, task_type task, tensor_size_t features = 0)
+{
+    write_data(data);
+
+    auto dataset = libsvm_dataset_t{data_path(), task, features};
+    dataset.load();
+
+    std::remove(data_path());
+    return dataset;
+}
+
+static void check_throw(const char* data, task_type task, tensor_size_t features = 0)
+{
+    write_data(data);
+
+    auto dataset = libsvm_dataset_t{data_path(), task, features};
+    UTEST_CHECK_THROW(dataset.load(), std::runtime_error);
+
+    std::remove(data_path());
+}
+
+UTEST_BEGIN_MODULE(test_dataset_libsvm)
+
+UTEST_CASE(sparse)
+{
+    indices_t offsets(4), findices(4);
+    tensor1d_t fvalues(4);
+    tensor4d_t targets(3, 1, 1, 1);
+
+    offsets(0) = 0, offsets(1) = 2, offsets(2) = 2, offsets(3) = 4;
+    findices(0) = 1, findices(1) = 4, findices(2) = 0, findices(3) = 4;
+    fvalues(0) = 1.5, fvalues(1) = -2.0, fvalues(2) = 3.0, fvalues(3) = 0.5;
+    targets.vector() = Eigen::VectorXd::LinSpaced(3, 1.0, 3.0);
+
+    const auto dataset = sparse_dataset_t{offsets, findices, fvalues, 5, targets};
+
+    UTEST_CHECK_EQUAL(dataset.samples(), 3);
+    UTEST_CHECK_EQUAL(dataset.nonzeros(), 4);
+    UTEST_CHECK_EQUAL(dataset.idim(), make_dims(5, 1, 1));
+    UTEST_CHECK_EQUAL(dataset.tdim(), make_dims(1, 1, 1));
+
+    const auto feature = dataset.feature(3);
+    UTEST_CHECK_EQUAL(feature.name(), "feature_3");
+
+    const auto samples = arange(0, 3);
+
+    const auto inputs = dataset.inputs(samples);
+    UTEST_REQUIRE_EQUAL(inputs.dims(), make_dims(3, 5, 1, 1));
+
+    tensor2d_t expected(3, 5);
+    expected.matrix() <<
+        0.0, 1.5, 0.0, 0.0, -2.0,
+        0.0, 0.0, 0.0, 0.0, 0.0,
+        3.0, 0.0, 0.0, 0.0, 0.5;
+    UTEST_CHECK_EIGEN_CLOSE(inputs.reshape(3, 5).matrix(), expected.matrix(), 1e-12);
+
+    for (tensor_size_t feature = 0; feature < 5; ++ feature)
+    {
+        UTEST_CHECK_EIGEN_CLOSE(dataset.inputs(samples, feature).vector(), expected.matrix().col(feature), 1e-12);
+    }
+
+    UTEST_CHECK_EIGEN_CLOSE(dataset.targets(samples).vector(), targets.vector(), 1e-12);
+}
+
+UTEST_CASE(sparse_invalid)
+{
+    const auto make_offsets = [] (tensor_size_t o0, tensor_size_t o1, tensor_size_t o2)
+    {
+        indices_t offsets(3);
+        offsets(0) = o0, offsets(1) = o1, offsets(2) = o2;
+        return offsets;
+    };
+
+    const auto make_findices = [] (tensor_size_t f0, tensor_size_t f1)
+    {
+        indices_t findices(2);
+        findices(0) = f0, findices(1) = f1;
+        return findices;
+    };
+
+    const auto fvalues = tensor1d_t{2};
+    const auto targets = tensor4d_t{2, 1, 1, 1};
+
+    UTEST_CHECK_NOTHROW(sparse_dataset_t(make_offsets(0, 2, 2), make_findices(0, 1), fvalues, 2, targets));
+    UTEST_CHECK_THROW(sparse_dataset_t(make_offsets(0, 2, 1), make_findices(0, 1), fvalues, 2, targets), std::runtime_error);
+    UTEST_CHECK_THROW(sparse_dataset_t(make_offsets(1, 2, 2), make_findices(0, 1), fvalues, 2, targets), std::runtime_error);
+    UTEST_CHECK_THROW(sparse_dataset_t(make_offsets(0, 2, 2), make_findices(1, 0), fvalues, 2, targets), std::runtime_error);
+    UTEST_CHECK_THROW(sparse_dataset_t(make_offsets(0, 2, 2), make_findices(0, 2), fvalues, 2, targets), std::runtime_error);
+    UTEST_CHECK_THROW(sparse_dataset_t(make_offsets(0, 2, 2), make_findices(0, 1), tensor1d_t{3}, 2, targets), std::runtime_error);
+}
+
+UTEST_CASE(regression)
+{
+    const auto dataset = load_data(
+        "# header comment\n"
+        "1.5 1:1.0 3:-2.0\n"
+        "\n"
+        "-0.5 4:0.5 2:3.0 # trailing comment\n"
+        "2.0\n",
+        task_type::regression);
+
+    UTEST_CHECK_EQUAL(dataset.samples(), 3);
+    UTEST_CHECK_EQUAL(dataset.nonzeros(), 4);
+    UTEST_CHECK_EQUAL(dataset.idim(), make_dims(4, 1, 1));
+    UTEST_CHECK_EQUAL(dataset.tdim(), make_dims(1, 1, 1));
+
+    const auto samples = arange(0, 3);
+
+    tensor2d_t expected(3, 4);
+    expected.matrix() <<
+        1.0, 0.0, -2.0, 0.0,
+        0.0, 3.0, 0.0, 0.5,
+        0.0, 0.0, 0.0, 0.0;
+    UTEST_CHECK_EIGEN_CLOSE(dataset.inputs(samples).reshape(3, 4).matrix(), expected.matrix(), 1e-12);
+
+    const auto targets = dataset.targets(samples);
+    UTEST_CHECK_CLOSE(targets(0), +1.5, 1e-12);
+    UTEST_CHECK_CLOSE(targets(1), -0.5, 1e-12);
+    UTEST_CHECK_CLOSE(targets(2), +2.0, 1e-12);
+}
+
+UTEST_CASE(sclassification)
+{
+    const auto dataset = load_data(
+        "b 1:1\n"
+        "a 2:1\n"
+        "c 1:2\n"
+        "a 3:1\n",
+        task_type::sclassification);
+
+    UTEST_CHECK_EQUAL(dataset.samples(), 4);
+    UTEST_CHECK_EQUAL(dataset.tdim(), make_dims(3, 1, 1));
+    UTEST_CHECK(dataset.target().labels() == strings_t({"a", "b", "c"}));
+
+    const auto targets = dataset.targets(arange(0, 4));
+    UTEST_CHECK_EQUAL(targets.dims(), make_dims(4, 3, 1, 1));
+
+    tensor2d_t expected(4, 3);
+    expected.matrix() <<
+        neg_target(), pos_target(), neg_target(),
+        pos_target(), neg_target(), neg_target(),
+        neg_target(), neg_target(), pos_target(),
+        pos_target(), neg_target(), neg_target();
+    UTEST_CHECK_EIGEN_CLOSE(targets.reshape(4, 3).matrix(), expected.matrix(), 1e-12);
+}
+
+UTEST_CASE(mclassification)
+{
+    const auto dataset = load_data(
+        "a,c 1:1\n"
+        "b 2:1\n"
+        "c,a,b 1:2\n",
+        task_type::mclassification);
+
+    UTEST_CHECK_EQUAL(dataset.samples(), 3);
+    UTEST_CHECK(dataset.target().labels() == strings_t({"a", "b", "c"}));
+
+    tensor2d_t expected(3, 3);
+    expected.matrix() <<
+        pos_target(), neg_target(), pos_target(),
+        neg_target(), pos_target(), neg_target(),
+        pos_target(), pos_target(), pos_target();
+    UTEST_CHECK_EIGEN_CLOSE(dataset.targets(arange(0, 3)).reshape(3, 3).matrix(), expected.matrix(), 1e-12);
+}
+
+UTEST_CASE(hashing)
+{
+    const auto dataset = load_data(
+        "1 1:1.0 4:2.0 6:0.5\n"
+        "0 3:1.0 7:-1.0\n",
+        task_type::sclassification, 3);
+
+    UTEST_CHECK_EQUAL(dataset.samples(), 2);
+    UTEST_CHECK_EQUAL(dataset.idim(), make_dims(3, 1, 1));
+
+    tensor2d_t expected(2, 3);
+    expected.matrix() <<
+        3.0, 0.0, 0.5,
+        -1.0, 0.0, 1.0;
+    UTEST_CHECK_EIGEN_CLOSE(dataset.inputs(arange(0, 2)).reshape(2, 3).matrix(), expected.matrix(), 1e-12);
+
+    const auto& findices = dataset.findices();
+    UTEST_CHECK_EQUAL(dataset.nonzeros(), 4);
+    UTEST_CHECK_EQUAL(findices(0), 0);
+    UTEST_CHECK_EQUAL(findices(1), 2);
+    UTEST_CHECK_EQUAL(findices(2), 0);
+    UTEST_CHECK_EQUAL(findices(3), 2);
+}
+
+UTEST_CASE(invalid)
+{
+    check_throw("1 0:1.0\n", task_type::regression);
+    check_throw("1 1=1.0\n", task_type::regression);
+    check_throw("1,2 1:1.0\n", task_type::regression);
+    check_throw("a,b 1:1.0\n", task_type::sclassification);
+    check_throw("1 1:1.0\n", task_type::unsupervised);
+    check_throw("# no samples\n", task_type::regression);
+    check_throw("1 1:1.0\n", task_type::regression, -1);
+
+    auto dataset = libsvm_dataset_t{"non-existing-file.txt", task_type::regression};
+    UTEST_CHECK_THROW(dataset.load(), std::runtime_error);
+}
+
+UTEST_END_MODULE()
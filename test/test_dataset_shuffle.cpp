@@ -92,4 +92,43 @@ UTEST_CASE(shuffle)
     }
 }
 
+UTEST_CASE(permute)
+{
+    auto source = fixture_dataset_t{};
+    source.resize(nano::make_dims(100, 1, 8, 8), nano::make_dims(100, 3, 1, 1));
+    UTEST_REQUIRE_NOTHROW(source.load());
+
+    indices_t permutation(100);
+    for (tensor_size_t s = 0; s < permutation.size(); ++ s)
+    {
+        permutation(s) = (s * 37 + 11) % 100;
+    }
+
+    const auto dataset = shuffle_dataset_t{source, 13, permutation};
+
+    const auto range = make_range(17, 42);
+    const auto samples = arange(range.begin(), range.end());
+    for (auto trial = 0; trial < 2; ++ trial)
+    {
+        const auto inputs = dataset.inputs(samples);
+        const auto inputs13 = dataset.inputs(samples, 13);
+        const auto inputs22 = dataset.inputs(samples, 22);
+        const auto inputsXX = dataset.inputs(samples, indices_t{make_dims(3), {1, 13, 7}});
+
+        const auto imatrix = inputs.reshape(range.size(), -1);
+        for (tensor_size_t s = range.begin(); s < range.end(); ++ s)
+        {
+            const auto row = s - range.begin();
+            const auto expected = fixture_dataset_t::value(permutation(s), 13);
+            UTEST_CHECK_EQUAL(imatrix(row, 13), expected);
+            UTEST_CHECK_EQUAL(imatrix(row, 22), fixture_dataset_t::value(s, 22));
+            UTEST_CHECK_EQUAL(inputs13(row), expected);
+            UTEST_CHECK_EQUAL(inputs22(row), fixture_dataset_t::value(s, 22));
+            UTEST_CHECK_EQUAL(inputsXX(row, 0), fixture_dataset_t::value(s, 1));
+            UTEST_CHECK_EQUAL(inputsXX(row, 1), expected);
+            UTEST_CHECK_EQUAL(inputsXX(row, 2), fixture_dataset_t::value(s, 7));
+        }
+    }
+}
+
 UTEST_END_MODULE()
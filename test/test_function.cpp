@@ -1,6 +1,7 @@
 #include <utest/utest.h>
 #include <nano/numeric.h>
 #include <nano/function.h>
+#include <nano/function/sphere.h>
 #include <nano/function/geometric.h>
 
 using namespace nano;
@@ -45,6 +46,78 @@ UTEST_CASE(vgrad)
         {
             const vector_t x0 = vector_t::Random(dims);
             UTEST_CHECK_LESS(function.grad_accuracy(x0), 10 * epsilon2<scalar_t>());
+            UTEST_CHECK_LESS(function.grad_accuracy(x0, 3), 10 * epsilon2<scalar_t>());
+            UTEST_CHECK_LESS(function.grad_accuracy(x0, 0, execution::par), 10 * epsilon2<scalar_t>());
+            UTEST_CHECK_LESS(function.grad_accuracy(x0, 3, execution::par), 10 * epsilon2<scalar_t>());
+        }
+    }
+}
+
+UTEST_CASE(hvp)
+{
+    for (const auto& rfunction : get_functions(1, 4, convexity::unknown, std::regex(".+")))
+    {
+        const auto& function = *rfunction;
+        std::cout << function.name() << std::endl;
+
+        const auto dims = function.size();
+        for (auto t = 0; t < 100; ++ t)
+        {
+            const vector_t x0 = vector_t::Random(dims);
+            const vector_t v1 = vector_t::Random(dims);
+            const vector_t v2 = vector_t::Random(dims);
+
+            // NB: the Hessian is symmetric
+            vector_t hv1, hv2;
+            function.hvp(x0, v1, hv1);
+            function.hvp(x0, v2, hv2);
+            UTEST_REQUIRE_EQUAL(hv1.size(), dims);
+            UTEST_REQUIRE_EQUAL(hv2.size(), dims);
+            UTEST_CHECK_CLOSE(v2.dot(hv1), v1.dot(hv2), epsilon2<scalar_t>());
+        }
+    }
+
+    const auto function = function_sphere_t{4};
+    for (auto t = 0; t < 100; ++ t)
+    {
+        const vector_t x0 = vector_t::Random(4);
+        const vector_t v = vector_t::Random(4);
+
+        vector_t hv;
+        function.hvp(x0, v, hv);
+        UTEST_CHECK_EIGEN_CLOSE(hv, 2 * v, epsilon2<scalar_t>());
+    }
+}
+
+UTEST_CASE(vgrads)
+{
+    for (const auto& rfunction : get_functions(1, 4, convexity::unknown, std::regex(".+")))
+    {
+        const auto& function = *rfunction;
+        std::cout << function.name() << std::endl;
+
+        const auto dims = function.size();
+        const matrix_t X = matrix_t::Random(11, dims);
+
+        vector_t fx, fx2;
+        matrix_t gx;
+        function.vgrads(X, fx, &gx);
+        function.vgrads(X, fx2);
+        UTEST_REQUIRE_EQUAL(fx.size(), X.rows());
+        UTEST_REQUIRE_EQUAL(fx2.size(), X.rows());
+        UTEST_REQUIRE_EQUAL(gx.rows(), X.rows());
+        UTEST_REQUIRE_EQUAL(gx.cols(), dims);
+
+        // NB: the batched evaluation should match the evaluation of each point in turn
+        for (tensor_size_t i = 0; i < X.rows(); ++ i)
+        {
+            const vector_t x = X.row(i).transpose();
+
+            vector_t g(dims);
+            const auto f = function.vgrad(x, &g);
+            UTEST_CHECK_CLOSE(fx(i), f, epsilon1<scalar_t>());
+            UTEST_CHECK_CLOSE(fx2(i), f, epsilon1<scalar_t>());
+            UTEST_CHECK_EIGEN_CLOSE(gx.row(i).transpose(), g, epsilon1<scalar_t>());
         }
     }
 }
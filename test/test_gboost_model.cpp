@@ -3,6 +3,7 @@
 #include <nano/numeric.h>
 #include "fixture/gboost.h"
 #include <nano/gboost/model.h>
+#include <nano/dataset/shuffle.h>
 
 using namespace nano;
 
@@ -111,6 +112,85 @@ static void check_predict(const dataset_t& dataset, const gboost_model_t& model)
     UTEST_CHECK_EIGEN_CLOSE(outputs.vector(), soutputs.vector(), 1e-8);
 }
 
+static void check_evaluate(const dataset_t& dataset, const loss_t& loss, const gboost_model_t& model)
+{
+    const auto samples = make_samples(dataset);
+    const auto targets = dataset.targets(samples);
+    const auto outputs = model.predict(dataset, samples);
+
+    tensor1d_t errors, expected_errors;
+    loss.error(targets, outputs, expected_errors);
+
+    // the errors should be computed batch-by-batch without storing all the predictions
+    UTEST_REQUIRE_NOTHROW(errors = model.evaluate(loss, dataset, samples));
+    UTEST_CHECK_EQUAL(errors.dims(), expected_errors.dims());
+    UTEST_CHECK_EIGEN_CLOSE(errors.vector(), expected_errors.vector(), 1e-12);
+}
+
+static void check_contributions(const dataset_t& dataset, const gboost_model_t& model)
+{
+    const auto samples = make_samples(dataset);
+    const auto outputs = model.predict(dataset, samples);
+
+    tensor3d_t contributions;
+    UTEST_REQUIRE_NOTHROW(contributions = model.contributions(dataset, samples));
+    UTEST_REQUIRE_EQUAL(contributions.dims(), make_dims(samples.size(), dataset.features() + 1, ::nano::size(dataset.tdim())));
+
+    // the contributions should sum up to the predictions
+    for (tensor_size_t s = 0; s < samples.size(); ++ s)
+    {
+        UTEST_CHECK_EIGEN_CLOSE(contributions.matrix(s).colwise().sum().transpose(), outputs.vector(s), 1e-8);
+    }
+
+    // the contributions of a sample should not depend on the other samples being explained
+    for (tensor_size_t s = 0; s < samples.size(); s += 17)
+    {
+        tensor3d_t scontributions;
+        UTEST_REQUIRE_NOTHROW(scontributions = model.contributions(dataset, indices_t{samples.slice(s, s + 1)}));
+        UTEST_CHECK_EIGEN_CLOSE(scontributions.vector(0), contributions.vector(s), 1e-12);
+    }
+
+    // only the selected features should contribute
+    const auto features = model.features();
+    for (tensor_size_t feature = 0; feature < dataset.features(); ++ feature)
+    {
+        const auto selected = std::any_of(features.begin(), features.end(),
+            [&] (const auto& info) { return info.feature() == feature; });
+        if (!selected)
+        {
+            for (tensor_size_t s = 0; s < samples.size(); ++ s)
+            {
+                UTEST_CHECK_CLOSE(contributions.matrix(s).row(feature).lpNorm<Eigen::Infinity>(), 0.0, 1e-12);
+            }
+        }
+    }
+}
+
+static void check_predict_shuffled(const dataset_t& dataset, const gboost_model_t& model)
+{
+    const auto samples = make_samples(dataset);
+    const auto outputs = model.predict(dataset, samples);
+
+    // fixed permutation: reverse the given samples
+    auto permutation = arange(0, dataset.samples());
+    for (tensor_size_t i = 0; i < samples.size(); ++ i)
+    {
+        permutation(samples(i)) = samples(samples.size() - 1 - i);
+    }
+
+    // the incremental update should match predicting the shuffled dataset
+    for (tensor_size_t feature = 0; feature < dataset.features(); ++ feature)
+    {
+        const auto fdataset = shuffle_dataset_t{dataset, feature, permutation};
+        const auto expected_outputs = model.predict(fdataset, samples);
+
+        tensor4d_t foutputs;
+        UTEST_REQUIRE_NOTHROW(foutputs = model.predict_shuffled(dataset, fdataset, feature, samples, outputs));
+        UTEST_REQUIRE_EQUAL(foutputs.dims(), expected_outputs.dims());
+        UTEST_CHECK_EIGEN_CLOSE(foutputs.vector(), expected_outputs.vector(), 1e-10);
+    }
+}
+
 static void check_features(const dataset_t& dataset, const loss_t& loss, const gboost_model_t& model)
 {
     const auto trials = 3;
@@ -197,7 +277,10 @@ UTEST_CASE(train_linear)
 
     UTEST_REQUIRE_NOTHROW(model.fit(*loss, dataset, samples, *solver));
     ::check_predict(dataset, model);
+    ::check_evaluate(dataset, *loss, model);
     ::check_features(dataset, *loss, model);
+    ::check_predict_shuffled(dataset, model);
+    ::check_contributions(dataset, model);
 }
 
 UTEST_CASE(train_mixed)
@@ -221,7 +304,10 @@ UTEST_CASE(train_mixed)
 
     UTEST_REQUIRE_NOTHROW(model.fit(*loss, dataset, samples, *solver));
     ::check_predict(dataset, model);
+    ::check_evaluate(dataset, *loss, model);
     ::check_features(dataset, *loss, model);
+    ::check_predict_shuffled(dataset, model);
+    ::check_contributions(dataset, model);
 }
 
 UTEST_END_MODULE()
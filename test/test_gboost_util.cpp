@@ -108,4 +108,65 @@ UTEST_CASE(accumulator)
     UTEST_CHECK_CLOSE(acc.r2(1).maxCoeff(), +46.0, 1e-12);
 }
 
+UTEST_CASE(accumulator_kernels)
+{
+    for (const auto tsize : {1, 2, 3, 4, 7})
+    {
+        const auto tdim = make_dims(tsize, 1, 1);
+        const auto samples = arange(0, 150);
+
+        tensor4d_t vgrads(cat_dims(samples.size(), tdim));
+        vgrads.random();
+
+        tensor1d_t fvalues(samples.size());
+        fvalues.random();
+        for (tensor_size_t i = 0; i < samples.size(); i += 7)
+        {
+            fvalues(i) = feature_t::placeholder_value();
+        }
+
+        const auto fun = [] (scalar_t value) { return 2.0 * value - 1.0; };
+
+        auto acc0 = gboost::accumulator_t(tdim);
+        auto acc1 = gboost::accumulator_t(tdim);
+        auto acc2 = gboost::accumulator_t(tdim);
+        auto acc3 = gboost::accumulator_t(tdim);
+        auto acc4 = gboost::accumulator_t(tdim);
+
+        for (tensor_size_t i = 0; i < samples.size(); ++ i)
+        {
+            if (!feature_t::missing(fvalues(i)))
+            {
+                acc0.update(fun(fvalues(i)), vgrads.array(i));
+                acc3.update(vgrads.array(i));
+                gboost::dispatch(tsize, [&] (auto tsize)
+                {
+                    acc1.update<tsize>(fun(fvalues(i)), vgrads.vector(i).data());
+                    acc4.update<tsize>(vgrads.vector(i).data());
+                });
+            }
+        }
+        acc2.update(fvalues, samples, vgrads, fun);
+
+        for (const auto* acc : {&acc1, &acc2})
+        {
+            UTEST_CHECK_CLOSE(acc->x0(), acc0.x0(), 1e-12);
+            UTEST_CHECK_CLOSE(acc->x1(), acc0.x1(), 1e-12);
+            UTEST_CHECK_CLOSE(acc->x2(), acc0.x2(), 1e-12);
+            UTEST_CHECK_EIGEN_CLOSE(acc->r1(), acc0.r1(), 1e-12);
+            UTEST_CHECK_EIGEN_CLOSE(acc->rx(), acc0.rx(), 1e-12);
+            UTEST_CHECK_EIGEN_CLOSE(acc->r2(), acc0.r2(), 1e-12);
+        }
+
+        acc2.clear();
+        acc2.update(fvalues, samples, vgrads);
+        for (const auto* acc : {&acc2, &acc4})
+        {
+            UTEST_CHECK_CLOSE(acc->x0(), acc3.x0(), 1e-12);
+            UTEST_CHECK_EIGEN_CLOSE(acc->r1(), acc3.r1(), 1e-12);
+            UTEST_CHECK_EIGEN_CLOSE(acc->r2(), acc3.r2(), 1e-12);
+        }
+    }
+}
+
 UTEST_END_MODULE()
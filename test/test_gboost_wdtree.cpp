@@ -1,5 +1,6 @@
 #include <utest/utest.h>
 #include <nano/numeric.h>
+#include <nano/tensor/stream.h>
 #include "fixture/gboost.h"
 
 using namespace nano;
@@ -281,6 +282,68 @@ public:
     }
 };
 
+static auto make_covers(const wlearner_dtree_t& wlearner, const tensor2d_t& inputs)
+{
+    // NB: number of samples reaching each node (first row) and each split (second row)
+    const auto& nodes = wlearner.nodes();
+
+    tensor2d_t covers(2, static_cast<tensor_size_t>(nodes.size()));
+    covers.zero();
+    for (tensor_size_t s = 0; s < inputs.size<0>(); ++ s)
+    {
+        for (size_t inode = 0; ; )
+        {
+            const auto& node = nodes[inode];
+            covers(1, static_cast<tensor_size_t>(inode)) += 1;
+
+            const auto x = inputs(s, node.m_feature);
+            if (feature_t::missing(x))
+            {
+                break;
+            }
+
+            const auto child = inode + static_cast<size_t>(node.m_classes > 0 ? x : (x < node.m_threshold ? 0.0 : 1.0));
+            covers(0, static_cast<tensor_size_t>(child)) += 1;
+            if (nodes[child].m_next <= inode)
+            {
+                break;
+            }
+            inode = nodes[child].m_next;
+        }
+    }
+
+    return covers;
+}
+
+static scalar_t expected_value(const wlearner_dtree_t& wlearner, const tensor2d_t& covers,
+    const tensor1d_cmap_t& inputs, const std::vector<bool>& known, size_t inode = 0U)
+{
+    const auto& nodes = wlearner.nodes();
+    const auto& node = nodes[inode];
+
+    const auto value = [&] (size_t child)
+    {
+        const auto next = nodes[child].m_next;
+        return  next > inode ? expected_value(wlearner, covers, inputs, known, next) :
+                nodes[child].m_table >= 0 ? wlearner.tables()(nodes[child].m_table, 0, 0, 0) : 0.0;
+    };
+
+    const auto x = inputs(node.m_feature);
+    if (known[static_cast<size_t>(node.m_feature)])
+    {
+        return  feature_t::missing(x) ? 0.0 :
+                value(inode + static_cast<size_t>(node.m_classes > 0 ? x : (x < node.m_threshold ? 0.0 : 1.0)));
+    }
+
+    scalar_t sum = 0.0;
+    for (size_t child = inode, end = inode + static_cast<size_t>(node.m_classes > 0 ? node.m_classes : 2); child < end; ++ child)
+    {
+        const auto cover = covers(0, static_cast<tensor_size_t>(child));
+        sum += cover > 0.0 ? cover * value(child) : 0.0;
+    }
+    return sum / covers(1, static_cast<tensor_size_t>(inode));
+}
+
 static auto make_wdtree(const wdtree_dataset_t& dataset)
 {
     auto wlearner = make_wlearner<wlearner_dtree_t>();
@@ -365,4 +428,200 @@ UTEST_CASE(fitting_depth3)
     check_wlearner(wlearner, dataset, datasetx1, datasetx2, datasetx3, datasetx4, datasetx5);
 }
 
+UTEST_CASE(fitting_deep)
+{
+    const auto dataset = make_dataset<wdtree_depth3_dataset_t>(10, 1, 400);
+
+    auto wlearner = make_wlearner<wlearner_dtree_t>();
+    wlearner.min_split(1);
+    wlearner.max_depth(10);
+
+    const auto fit_score = check_fit(wlearner, dataset);
+    UTEST_CHECK_LESS(fit_score, wlearner_t::no_fit_score());
+
+    tensor_size_t leaves = 0;
+    for (const auto& node : wlearner.nodes())
+    {
+        UTEST_CHECK_LESS(node.m_table, wlearner.tables().size<0>());
+        leaves += node.m_table >= 0 ? 1 : 0;
+    }
+    UTEST_CHECK_EQUAL(leaves, wlearner.tables().size<0>());
+
+    const auto samples = make_samples(dataset);
+    const auto& base = static_cast<const wlearner_t&>(wlearner);
+    UTEST_CHECK_NOTHROW(base.predict(dataset, samples));
+    UTEST_CHECK_NOTHROW(base.split(dataset, samples));
+
+    // the fitting score should be the training error of the samples reaching the leaves,
+    //  also of the ones reaching the nodes that could not be split further
+    const auto residuals = make_residuals(dataset, *make_loss());
+    const auto outputs = base.predict(dataset, samples);
+    const auto cluster = base.split(dataset, samples);
+
+    scalar_t error = 0;
+    for (tensor_size_t i = 0; i < samples.size(); ++ i)
+    {
+        if (cluster.group(i) >= 0)
+        {
+            error += (residuals.array(samples(i)) + outputs.array(i)).square().sum();
+        }
+    }
+    UTEST_CHECK_CLOSE(fit_score, error, 1e-8);
+}
+
+UTEST_CASE(contributions)
+{
+    const auto dataset = make_dataset<wdtree_depth3_dataset_t>(10, 1, 400);
+    const auto samples = make_samples(dataset);
+
+    const auto n_features = static_cast<const dataset_t&>(dataset).features();
+
+    auto wlearner = make_wdtree(dataset);
+    UTEST_CHECK_LESS(check_fit(wlearner, dataset), wlearner_t::no_fit_score());
+
+    const auto& base = static_cast<const wlearner_t&>(wlearner);
+    const auto outputs = base.predict(dataset, samples);
+
+    tensor3d_t contributions(samples.size(), n_features + 1, 1);
+    contributions.zero();
+    UTEST_REQUIRE_NOTHROW(base.contributions(dataset, samples, contributions));
+
+    // the contributions should sum up to the predictions
+    for (tensor_size_t s = 0; s < samples.size(); ++ s)
+    {
+        UTEST_CHECK_CLOSE(contributions.matrix(s).sum(), outputs(s, 0, 0, 0), 1e-8);
+    }
+
+    // the contributions of a sample should not depend on the other samples being explained
+    for (tensor_size_t s = 0; s < samples.size(); s += 11)
+    {
+        tensor3d_t scontributions(1, n_features + 1, 1);
+        scontributions.zero();
+        UTEST_REQUIRE_NOTHROW(base.contributions(dataset, indices_t{samples.slice(s, s + 1)}, scontributions));
+        UTEST_CHECK_EIGEN_CLOSE(scontributions.vector(0), contributions.vector(s), 1e-12);
+    }
+
+    // the contributions should match the exact Shapley values
+    const auto features = wlearner.features();
+    const auto inputs = dataset.inputs(samples, features);
+    const auto covers = make_covers(wlearner, inputs);
+
+    const auto M = static_cast<size_t>(features.size());
+    const auto factorial = [] (size_t n) { return n <= 1 ? 1.0 : std::tgamma(static_cast<scalar_t>(n + 1)); };
+
+    for (tensor_size_t s = 0; s < samples.size(); s += 11)
+    {
+        const auto x = inputs.tensor(s);
+        UTEST_CHECK_CLOSE(contributions(s, n_features, 0),
+            expected_value(wlearner, covers, x, std::vector<bool>(M, false)), 1e-8);
+
+        for (size_t j = 0; j < M; ++ j)
+        {
+            scalar_t phi = 0.0;
+            for (size_t mask = 0; mask < (size_t(1) << M); ++ mask)
+            {
+                if ((mask >> j) & 1U)
+                {
+                    continue;
+                }
+
+                std::vector<bool> known(M, false);
+                size_t count = 0;
+                for (size_t k = 0; k < M; ++ k)
+                {
+                    known[k] = ((mask >> k) & 1U) != 0U;
+                    count += known[k] ? 1U : 0U;
+                }
+
+                const auto v0 = expected_value(wlearner, covers, x, known);
+                known[j] = true;
+                const auto v1 = expected_value(wlearner, covers, x, known);
+
+                phi += factorial(count) * factorial(M - count - 1) / factorial(M) * (v1 - v0);
+            }
+
+            UTEST_CHECK_CLOSE(contributions(s, features(static_cast<tensor_size_t>(j)), 0), phi, 1e-8);
+        }
+    }
+
+    // the features not used by the tree have no contribution
+    for (tensor_size_t feature = 0; feature < n_features; ++ feature)
+    {
+        if (std::find(features.begin(), features.end(), feature) == features.end())
+        {
+            for (tensor_size_t s = 0; s < samples.size(); ++ s)
+            {
+                UTEST_CHECK_CLOSE(contributions(s, feature, 0), 0.0, 1e-12);
+            }
+        }
+    }
+}
+
+UTEST_CASE(read_version_1_0_0)
+{
+    const auto dataset = make_dataset<wdtree_depth3_dataset_t>(10, 1, 400);
+    const auto samples = make_samples(dataset);
+
+    auto wlearner = make_wdtree(dataset);
+    UTEST_CHECK_LESS(check_fit(wlearner, dataset), wlearner_t::no_fit_score());
+
+    const auto tensor_bytes = [] (const auto& tensor)
+    {
+        std::ostringstream stream;
+        UTEST_REQUIRE(::nano::write(stream, tensor));
+        return stream.str().size();
+    };
+
+    // emulate a stream written with version 1.0.0: without the expected prediction and the node covers
+    std::ostringstream ostream;
+    UTEST_REQUIRE_NOTHROW(wlearner.write(ostream));
+    auto str = ostream.str();
+
+    const auto expected_bytes = tensor_bytes(wlearner.expected());
+    const auto covers_bytes = tensor_bytes(tensor2d_t{2, static_cast<tensor_size_t>(wlearner.nodes().size())});
+
+    const auto header_bytes = size_t(4 * 4);
+    UTEST_REQUIRE_GREATER(str.size(), header_bytes + expected_bytes + covers_bytes);
+    str.erase(str.size() - covers_bytes);
+    str.erase(header_bytes, expected_bytes);
+
+    reinterpret_cast<int32_t*>(str.data())[0] = 1; // NOLINT
+    reinterpret_cast<int32_t*>(str.data())[1] = 0; // NOLINT
+    reinterpret_cast<int32_t*>(str.data())[2] = 0; // NOLINT
+
+    std::istringstream istream(str);
+    auto iwlearner = wlearner_dtree_t{};
+    UTEST_REQUIRE_NOTHROW(iwlearner.read(istream));
+    UTEST_CHECK_EQUAL(static_cast<size_t>(istream.tellg()), str.size());
+
+    // the tree is restored, but its feature contributions cannot be computed
+    UTEST_CHECK_EQUAL(iwlearner.nodes(), wlearner.nodes());
+    UTEST_CHECK_EQUAL(iwlearner.features(), wlearner.features());
+    UTEST_CHECK_EQUAL(iwlearner.tables(), wlearner.tables());
+
+    const auto& base = static_cast<const wlearner_t&>(iwlearner);
+    tensor3d_t contributions(samples.size(), static_cast<const dataset_t&>(dataset).features() + 1, 1);
+    contributions.zero();
+    UTEST_CHECK_THROW(base.contributions(dataset, samples, contributions), std::runtime_error);
+}
+
+UTEST_CASE(fitting_unsplittable)
+{
+    const auto dataset = make_dataset<wdtree_depth3_dataset_t>(10, 1, 400);
+
+    const auto loss = make_loss();
+    const auto residuals = make_residuals(dataset, *loss);
+
+    auto wlearner = make_wlearner<wlearner_dtree_t>();
+    wlearner.min_split(1);
+    wlearner.max_depth(10);
+
+    // NB: a single sample cannot be split at the root
+    const auto samples = arange(dataset.samples() / 2, dataset.samples() / 2 + 1);
+    UTEST_CHECK_EQUAL(wlearner.fit(dataset, samples, residuals), wlearner_t::no_fit_score());
+    UTEST_CHECK(wlearner.nodes().empty());
+    UTEST_CHECK_EQUAL(wlearner.tables().size<0>(), 0);
+    UTEST_CHECK_EQUAL(wlearner.features().size(), 0);
+}
+
 UTEST_END_MODULE()
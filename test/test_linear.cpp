@@ -3,6 +3,9 @@
 #include <nano/linear/util.h>
 #include <nano/linear/model.h>
 #include <nano/linear/function.h>
+#include <nano/linear/proximal.h>
+#include <nano/dataset/sparse.h>
+#include <nano/solver/stochastic.h>
 #include <nano/dataset/synth_affine.h>
 
 using namespace nano;
@@ -24,6 +27,34 @@ static auto make_dataset(const tensor_size_t isize = 5, const tensor_size_t tsiz
     return dataset;
 }
 
+static auto make_sparse_dataset(const synthetic_affine_dataset_t& dataset, const tensor_size_t modulo = 1)
+{
+    // NB: keep only the features with the index multiple of the given modulo
+    const auto samples = dataset.samples();
+    const auto features = size(dataset.idim());
+    const auto inputs = dataset.inputs(arange(0, samples));
+
+    std::vector<tensor_size_t> offsets{0}, findices;
+    std::vector<scalar_t> fvalues;
+    for (tensor_size_t s = 0; s < samples; ++ s)
+    {
+        for (tensor_size_t f = 0; f < features; f += modulo)
+        {
+            findices.push_back(f);
+            fvalues.push_back(inputs.vector(s)(f));
+        }
+        offsets.push_back(static_cast<tensor_size_t>(findices.size()));
+    }
+
+    const auto nonzeros = static_cast<tensor_size_t>(findices.size());
+    return sparse_dataset_t{
+        indices_t{map_tensor(offsets.data(), samples + 1)},
+        indices_t{map_tensor(findices.data(), nonzeros)},
+        tensor1d_t{map_tensor(fvalues.data(), nonzeros)},
+        features,
+        dataset.targets(arange(0, samples))};
+}
+
 UTEST_BEGIN_MODULE(test_linear)
 
 UTEST_CASE(predict)
@@ -73,6 +104,23 @@ UTEST_CASE(evaluate)
         UTEST_REQUIRE_NOTHROW(function.batch(batch));
         UTEST_CHECK_LESS(std::fabs(function.vgrad(x) - values.vector().mean()), epsilon1<scalar_t>());
     }
+
+    // NB: the cached inputs should be re-normalized when changing the normalization method
+    for (const auto normalization : enum_values<::nano::normalization>())
+    {
+        auto ninputs = inputs;
+        function.istats().scale(normalization, ninputs);
+        linear::predict(ninputs, function.weights(x), function.bias(x), outputs);
+        loss->value(targets, outputs, values);
+
+        UTEST_REQUIRE_NOTHROW(function.normalization(normalization));
+        UTEST_CHECK_LESS(std::fabs(function.vgrad(x) - values.vector().mean()), epsilon1<scalar_t>());
+
+        // NB: ... or they can be normalized directly at construction
+        const auto nfunction = linear_function_t{*loss, dataset, samples, normalization};
+        UTEST_CHECK(nfunction.normalization() == normalization);
+        UTEST_CHECK_LESS(std::fabs(nfunction.vgrad(x) - values.vector().mean()), epsilon1<scalar_t>());
+    }
 }
 
 UTEST_CASE(gradient)
@@ -104,10 +152,225 @@ UTEST_CASE(gradient)
     }
 }
 
-UTEST_CASE(minimize)
+UTEST_CASE(precision)
 {
     const auto loss = make_loss();
+    const auto dataset = make_dataset();
+    const auto samples = make_samples();
+
+    auto function = linear_function_t{*loss, dataset, samples};
+    UTEST_REQUIRE_NOTHROW(function.l1reg(1e-1));
+    UTEST_REQUIRE_NOTHROW(function.l2reg(1e+1));
+    UTEST_REQUIRE_NOTHROW(function.vAreg(5e-1));
+
+    const vector_t x = vector_t::Random(function.size());
+
+    for (const auto normalization : enum_values<::nano::normalization>())
+    {
+        vector_t gx64(function.size()), gx32(function.size());
+
+        UTEST_REQUIRE_NOTHROW(function.normalization(normalization));
+        UTEST_REQUIRE_NOTHROW(function.precision(::nano::precision::f64));
+        const auto fx64 = function.vgrad(x, &gx64);
+
+        UTEST_REQUIRE_NOTHROW(function.precision(::nano::precision::f32));
+        const auto fx32 = function.vgrad(x, &gx32);
+
+        UTEST_CHECK_CLOSE(fx32, fx64, 1e-5);
+        UTEST_CHECK_EIGEN_CLOSE(gx32, gx64, 1e-5);
+    }
+
     const auto solver = make_solver("cgd", epsilon3<scalar_t>());
+    const auto dataset32 = make_dataset(3, 2);
+
+    auto model = linear_model_t{};
+    UTEST_REQUIRE_NOTHROW(model.precision(::nano::precision::f32));
+    UTEST_REQUIRE_NOTHROW(model.fit(*loss, dataset32, samples, *solver));
+    UTEST_CHECK_EIGEN_CLOSE(model.bias().vector(), dataset32.bias(), 1e-3);
+    UTEST_CHECK_EIGEN_CLOSE(model.weights().matrix(), dataset32.weights(), 1e-3);
+}
+
+UTEST_CASE(precision_large_batch)
+{
+    const auto loss = make_loss();
+    const auto samples = arange(0, 4000);
+
+    auto dataset = synthetic_affine_dataset_t{};
+    dataset.noise(epsilon1<scalar_t>());
+    dataset.idim(make_dims(10, 1, 1));
+    dataset.tdim(make_dims(3, 1, 1));
+    dataset.modulo(1);
+    dataset.samples(samples.size());
+    UTEST_REQUIRE_NOTHROW(dataset.load());
+
+    // NB: the gradients are cumulated in double precision over the samples of a batch,
+    //  so the single precision error doesn't grow with the batch size.
+    auto function32 = linear_function_t{*loss, dataset, samples, ::nano::normalization::none, ::nano::precision::f32};
+    auto function64 = linear_function_t{*loss, dataset, samples, ::nano::normalization::none, ::nano::precision::f64};
+    UTEST_REQUIRE_NOTHROW(function32.batch(samples.size()));
+    UTEST_REQUIRE_NOTHROW(function64.batch(samples.size()));
+
+    const vector_t x = vector_t::Random(function64.size());
+
+    vector_t gx32(x.size()), gx64(x.size());
+    const auto fx32 = function32.vgrad(x, &gx32);
+    const auto fx64 = function64.vgrad(x, &gx64);
+
+    UTEST_CHECK_CLOSE(fx32, fx64, 1e-6);
+    UTEST_CHECK_LESS((gx32 - gx64).lpNorm<Eigen::Infinity>(), 5e-8 * (1 + gx64.lpNorm<Eigen::Infinity>()));
+
+    vector_t hv32(x.size()), hv64(x.size());
+    UTEST_REQUIRE_NOTHROW(function32.hvp(x, gx64, hv32));
+    UTEST_REQUIRE_NOTHROW(function64.hvp(x, gx64, hv64));
+    UTEST_CHECK_LESS((hv32 - hv64).lpNorm<Eigen::Infinity>(), 1e-6 * (1 + hv64.lpNorm<Eigen::Infinity>()));
+}
+
+UTEST_CASE(partial)
+{
+    const auto loss = make_loss();
+    const auto dataset = make_dataset();
+    const auto samples = make_samples();
+
+    auto function = linear_function_t{*loss, dataset, samples};
+    UTEST_REQUIRE_EQUAL(function.summands(), samples.size());
+    UTEST_REQUIRE_NOTHROW(function.l1reg(1e-1));
+    UTEST_REQUIRE_NOTHROW(function.l2reg(1e+1));
+    UTEST_REQUIRE_NOTHROW(function.vAreg(5e-1));
+
+    const vector_t x = vector_t::Random(function.size());
+
+    // NB: evaluating a subset of samples should be equivalent to evaluating the function built from that subset
+    const auto subset = indices_t{make_dims(5), {13, 2, 97, 45, 46}};
+
+    auto sfunction = linear_function_t{*loss, dataset, subset};
+    UTEST_REQUIRE_NOTHROW(sfunction.l1reg(1e-1));
+    UTEST_REQUIRE_NOTHROW(sfunction.l2reg(1e+1));
+    UTEST_REQUIRE_NOTHROW(sfunction.vAreg(5e-1));
+
+    for (const auto precision : enum_values<::nano::precision>())
+    {
+        UTEST_REQUIRE_NOTHROW(function.precision(precision));
+        UTEST_REQUIRE_NOTHROW(sfunction.precision(precision));
+
+        // NB: the single precision results depend on the order of cumulation
+        const auto epsilon = (precision == ::nano::precision::f32) ? 1e-6 : epsilon1<scalar_t>();
+
+        for (tensor_size_t batch = 1; batch <= 6; ++ batch)
+        {
+            UTEST_REQUIRE_NOTHROW(function.batch(batch));
+
+            vector_t gx(function.size()), gx_expected(function.size());
+            const auto fx = function.partial_vgrad(x, subset, &gx);
+            const auto fx_expected = sfunction.vgrad(x, &gx_expected);
+
+            UTEST_CHECK_CLOSE(fx, fx_expected, epsilon);
+            UTEST_CHECK_EIGEN_CLOSE(gx, gx_expected, epsilon);
+
+            const auto fx_all = function.partial_vgrad(x, samples, &gx);
+            UTEST_CHECK_CLOSE(fx_all, function.vgrad(x, &gx_expected), epsilon);
+            UTEST_CHECK_EIGEN_CLOSE(gx, gx_expected, epsilon);
+        }
+    }
+}
+
+UTEST_CASE(hessian)
+{
+    const auto dataset = make_dataset();
+    const auto sdataset = make_sparse_dataset(dataset);
+    const auto samples = make_samples();
+
+    for (const auto* const loss_id : {"squared", "cauchy", "m-logistic", "s-classnll"})
+    {
+        const auto loss = make_loss(loss_id);
+
+        auto function = linear_function_t{*loss, dataset, samples};
+        auto sfunction = linear_function_t{*loss, sdataset, samples};
+        UTEST_REQUIRE_NOTHROW(function.l2reg(1e+1));
+        UTEST_REQUIRE_NOTHROW(sfunction.l2reg(1e+1));
+
+        const vector_t x = vector_t::Random(function.size());
+        const vector_t v = vector_t::Random(function.size());
+
+        // NB: the Hessian-vector products should match the finite difference of the gradients,
+        //  more accurately if the loss implements the exact products (e.g. not the Cauchy loss).
+        const auto epsilon = (string_t{loss_id} == "cauchy") ? 1e-6 : 1e-8;
+
+        vector_t hv, hv_expected;
+        function.function_t::hvp(x, v, hv_expected);
+
+        UTEST_REQUIRE_NOTHROW(function.hvp(x, v, hv));
+        UTEST_CHECK_EIGEN_CLOSE(hv, hv_expected, epsilon);
+
+        UTEST_REQUIRE_NOTHROW(sfunction.hvp(x, v, hv));
+        UTEST_CHECK_EIGEN_CLOSE(hv, hv_expected, epsilon);
+
+        UTEST_REQUIRE_NOTHROW(function.precision(::nano::precision::f32));
+        UTEST_REQUIRE_NOTHROW(function.hvp(x, v, hv));
+        UTEST_CHECK_EIGEN_CLOSE(hv, hv_expected, 1e-4);
+
+        UTEST_REQUIRE_NOTHROW(function.hvp(x, vector_t::Zero(function.size()), hv));
+        UTEST_CHECK_EIGEN_CLOSE(hv, vector_t::Zero(function.size()), 1e-12);
+        UTEST_CHECK_EQUAL(function.hvp_bytes(), function.bytes());
+
+        // NB: the variance regularization uses the default implementation
+        UTEST_REQUIRE_NOTHROW(function.precision(::nano::precision::f64));
+        UTEST_REQUIRE_NOTHROW(function.vAreg(5e-1));
+        UTEST_CHECK_EQUAL(function.hvp_bytes(), 2 * function.bytes());
+        function.function_t::hvp(x, v, hv_expected);
+        UTEST_REQUIRE_NOTHROW(function.hvp(x, v, hv));
+        UTEST_CHECK_EIGEN_CLOSE(hv, hv_expected, 1e-12);
+    }
+}
+
+UTEST_CASE(minimize_stochastic)
+{
+    const auto loss = make_loss();
+    const auto dataset = make_dataset(3, 2);
+    const auto samples = make_samples();
+
+    auto function = linear_function_t{*loss, dataset, samples};
+    UTEST_REQUIRE_NOTHROW(function.l1reg(0.0));
+    UTEST_REQUIRE_NOTHROW(function.l2reg(0.0));
+    UTEST_REQUIRE_NOTHROW(function.vAreg(0.0));
+
+    const auto check = [&] (solver_stochastic_t& solver, const scalar_t lrate, const scalar_t epsilon,
+        const tensor_size_t pcalls_per_batch = 1)
+    {
+        UTEST_REQUIRE_NOTHROW(solver.batch(10));
+        UTEST_REQUIRE_NOTHROW(solver.lrate(lrate));
+        UTEST_REQUIRE_NOTHROW(solver.epsilon(epsilon3<scalar_t>()));
+        UTEST_REQUIRE_NOTHROW(solver.max_iterations(500));
+
+        const auto state = solver.minimize(function, vector_t::Zero(function.size()));
+        UTEST_CHECK(state);
+
+        // NB: the mini-batches are counted separately from the full evaluations at the end of each epoch
+        UTEST_CHECK_EQUAL(state.m_fcalls, state.m_iterations);
+        UTEST_CHECK_EQUAL(state.m_pcalls, (state.m_iterations - 1) * pcalls_per_batch * samples.size() / 10);
+        UTEST_CHECK_EIGEN_CLOSE(function.bias(state.x).vector(), dataset.bias(), epsilon);
+        UTEST_CHECK_EIGEN_CLOSE(function.weights(state.x).matrix(), dataset.weights(), epsilon);
+        return state;
+    };
+
+    {
+        auto solver = solver_sgd_t{};
+        check(solver, 1e-2, 1e-2);
+    }
+    {
+        auto solver = solver_adam_t{};
+        check(solver, 1e-2, 1e-2);
+    }
+    {
+        // NB: SVRG converges linearly for strongly convex functions
+        auto solver = solver_svrg_t{};
+        const auto state = check(solver, 1e-1, 1e+1 * epsilon3<scalar_t>(), 2);
+        UTEST_CHECK(state.converged(solver.epsilon()));
+    }
+}
+
+UTEST_CASE(minimize)
+{
+    const auto loss = make_loss();
     const auto dataset = make_dataset(3, 2);
     const auto samples = make_samples();
 
@@ -117,12 +380,63 @@ UTEST_CASE(minimize)
     UTEST_REQUIRE_NOTHROW(function.l2reg(0.0));
     UTEST_REQUIRE_NOTHROW(function.vAreg(0.0));
 
-    const auto state = solver->minimize(function, vector_t::Zero(function.size()));
-    UTEST_CHECK(state);
-    UTEST_CHECK(state.converged(solver->epsilon()));
+    for (const auto* const solver_id : {"cgd", "newton"})
+    {
+        const auto solver = make_solver(solver_id, epsilon3<scalar_t>());
+
+        const auto state = solver->minimize(function, vector_t::Zero(function.size()));
+        UTEST_CHECK(state);
+        UTEST_CHECK(state.converged(solver->epsilon()));
+
+        UTEST_CHECK_EIGEN_CLOSE(function.bias(state.x).vector(), dataset.bias(), 1e+1 * solver->epsilon());
+        UTEST_CHECK_EIGEN_CLOSE(function.weights(state.x).matrix(), dataset.weights(), 1e+1 * solver->epsilon());
+    }
+}
+
+UTEST_CASE(closed_form)
+{
+    const auto dataset = make_dataset(4, 3);
+    const auto samples = make_samples();
+
+    {
+        const auto loss = make_loss("absolute");
+        const auto function = linear_function_t{*loss, dataset, samples};
+        UTEST_CHECK(!function.closed_form());
+        UTEST_CHECK_THROW(function.solve(), std::runtime_error);
+    }
+
+    const auto loss = make_loss("squared");
+    auto function = linear_function_t{*loss, dataset, samples};
+    UTEST_CHECK(function.closed_form());
+
+    UTEST_REQUIRE_NOTHROW(function.vAreg(1e-1));
+    UTEST_CHECK(!function.closed_form());
+    UTEST_REQUIRE_NOTHROW(function.vAreg(0.0));
+
+    UTEST_REQUIRE_NOTHROW(function.l1reg(1e-1));
+    UTEST_CHECK(!function.closed_form());
+    UTEST_REQUIRE_NOTHROW(function.l1reg(0.0));
+
+    for (const auto l2reg : {0.0, 1e-1, 1e+1})
+    {
+        UTEST_REQUIRE_NOTHROW(function.l2reg(l2reg));
+        UTEST_CHECK(function.closed_form());
 
-    UTEST_CHECK_EIGEN_CLOSE(function.bias(state.x).vector(), dataset.bias(), 1e+1 * solver->epsilon());
-    UTEST_CHECK_EIGEN_CLOSE(function.weights(state.x).matrix(), dataset.weights(), 1e+1 * solver->epsilon());
+        for (const auto precision : enum_values<::nano::precision>())
+        {
+            UTEST_REQUIRE_NOTHROW(function.precision(precision));
+            for (const auto normalization : enum_values<::nano::normalization>())
+            {
+                UTEST_REQUIRE_NOTHROW(function.normalization(normalization));
+
+                // NB: the gradient should be zero at the optimum
+                const auto x = function.solve();
+                const auto state = solver_state_t{function, x};
+                UTEST_CHECK(state);
+                UTEST_CHECK_LESS(state.g.lpNorm<Eigen::Infinity>(), 1e-6);
+            }
+        }
+    }
 }
 
 UTEST_CASE(train)
@@ -169,6 +483,11 @@ UTEST_CASE(train)
         UTEST_REQUIRE_NOTHROW(outputs = model.predict(dataset, samples));
         UTEST_CHECK_EIGEN_CLOSE(targets.vector(), outputs.vector(), 1e+1 * solver->epsilon());
 
+        tensor1d_t errors, expected_errors;
+        loss->error(targets, outputs, expected_errors);
+        UTEST_REQUIRE_NOTHROW(errors = model.evaluate(*loss, dataset, samples));
+        UTEST_CHECK_EIGEN_CLOSE(errors.vector(), expected_errors.vector(), epsilon0<scalar_t>());
+
         string_t str;
         {
             std::ostringstream stream;
@@ -185,4 +504,149 @@ UTEST_CASE(train)
     }
 }
 
+UTEST_CASE(path)
+{
+    const auto loss = make_loss("cauchy");
+    const auto solver = make_solver("lbfgs", epsilon3<scalar_t>());
+    const auto dataset = make_dataset(3, 2);
+    const auto samples = make_samples();
+
+    const auto values = std::vector<scalar_t>{1e-2, 1e+0, 0.0, 1e-1};
+
+    auto model = linear_model_t{};
+    UTEST_CHECK_THROW(model.fit(*loss, dataset, samples, *solver, "linear::batch", values), std::runtime_error);
+    UTEST_CHECK_THROW(model.fit(*loss, dataset, samples, *solver, "linear::l2reg", {}), std::runtime_error);
+
+    for (const auto* const param : {"linear::l1reg", "linear::l2reg", "linear::vAreg"})
+    {
+        auto path_model = linear_model_t{};
+        std::vector<linear_model_t> models;
+        UTEST_REQUIRE_NOTHROW(models = path_model.fit(*loss, dataset, samples, *solver, param, values));
+        UTEST_REQUIRE_EQUAL(models.size(), values.size());
+
+        // NB: the path is fitted in the descending order of the regularization factor
+        UTEST_CHECK_EQUAL(models[0].svalue(param), 1e+0);
+        UTEST_CHECK_EQUAL(models[1].svalue(param), 1e-1);
+        UTEST_CHECK_EQUAL(models[2].svalue(param), 1e-2);
+        UTEST_CHECK_EQUAL(models[3].svalue(param), 0.0);
+        UTEST_CHECK_EQUAL(path_model.svalue(param), 0.0);
+
+        // NB: the warm-started solutions should match the ones obtained by fitting from scratch
+        //  (except for the non-smooth L1-norm regularization)
+        if (string_t(param) == "linear::l1reg")
+        {
+            continue;
+        }
+
+        for (const auto& pmodel : models)
+        {
+            auto cmodel = linear_model_t{};
+            UTEST_REQUIRE_NOTHROW(cmodel.set(param, pmodel.svalue(param)));
+            UTEST_REQUIRE_NOTHROW(cmodel.fit(*loss, dataset, samples, *solver));
+            UTEST_CHECK_EIGEN_CLOSE(cmodel.bias().vector(), pmodel.bias().vector(), 1e+2 * solver->epsilon());
+            UTEST_CHECK_EIGEN_CLOSE(cmodel.weights().matrix(), pmodel.weights().matrix(), 1e+2 * solver->epsilon());
+        }
+    }
+}
+
+UTEST_CASE(lasso)
+{
+    const auto loss = make_loss("squared");
+    const auto dataset = make_dataset(8, 3);
+    const auto samples = make_samples();
+
+    auto function = linear_function_t{*loss, dataset, samples};
+    UTEST_REQUIRE_NOTHROW(function.normalization(::nano::normalization::standard));
+
+    for (const auto l1reg : {1e-2, 1e+0, 1e+1})
+    {
+        UTEST_REQUIRE_NOTHROW(function.l1reg(l1reg));
+
+        const auto state = linear::fista(function, vector_t::Zero(function.size()), epsilon3<scalar_t>(), 1000);
+        UTEST_CHECK(state);
+        UTEST_CHECK_EQUAL(state.m_status, solver_state_t::status::converged);
+        UTEST_CHECK_LESS(state.convergence_criterion(), 1e+1 * epsilon3<scalar_t>());
+        UTEST_CHECK_EQUAL(function.l1reg(), l1reg);
+
+        // NB: the smooth solvers using the sign() subgradient cannot reach a lower criterion
+        const auto solver = make_solver("lbfgs", epsilon3<scalar_t>());
+        const auto sstate = solver->minimize(function, vector_t::Zero(function.size()));
+        UTEST_CHECK_LESS_EQUAL(state.f, sstate.f + epsilon2<scalar_t>());
+
+        // NB: strong regularization should produce exactly sparse weights
+        const auto zeros = (function.weights(state.x).array() == 0).count();
+        if (l1reg >= 1e+1)
+        {
+            UTEST_CHECK_GREATER(zeros, 0);
+        }
+    }
+
+    auto model = linear_model_t{};
+    UTEST_REQUIRE_NOTHROW(model.l1reg(1e+1));
+    UTEST_REQUIRE_NOTHROW(model.fit(*loss, dataset, samples, *make_solver("lbfgs", epsilon3<scalar_t>())));
+    UTEST_CHECK_GREATER((model.weights().array() == 0).count(), 0);
+}
+
+UTEST_CASE(sparse)
+{
+    const auto loss = make_loss();
+    const auto dataset = make_dataset();
+    const auto sdataset = make_sparse_dataset(dataset);
+    const auto samples = make_samples();
+
+    UTEST_REQUIRE_EQUAL(sdataset.nonzeros(), 5 * samples.size());
+
+    auto function = linear_function_t{*loss, dataset, samples};
+    auto sfunction = linear_function_t{*loss, sdataset, samples};
+
+    for (auto* pfunction : {&function, &sfunction})
+    {
+        UTEST_REQUIRE_NOTHROW(pfunction->l1reg(1e-1));
+        UTEST_REQUIRE_NOTHROW(pfunction->l2reg(1e+1));
+        UTEST_REQUIRE_NOTHROW(pfunction->vAreg(5e-1));
+        UTEST_REQUIRE_NOTHROW(pfunction->normalization(::nano::normalization::none));
+    }
+
+    // NB: the sparse inputs are not normalized and processed in double precision
+    UTEST_REQUIRE_NOTHROW(sfunction.normalization(::nano::normalization::standard));
+    UTEST_REQUIRE_NOTHROW(sfunction.precision(::nano::precision::f32));
+    UTEST_CHECK(sfunction.normalization() == ::nano::normalization::none);
+    UTEST_CHECK(sfunction.precision() == ::nano::precision::f64);
+
+    const vector_t x = vector_t::Random(function.size());
+    const auto subset = indices_t{make_dims(5), {13, 2, 97, 45, 46}};
+
+    for (tensor_size_t batch = 1; batch <= 6; ++ batch)
+    {
+        UTEST_REQUIRE_NOTHROW(function.batch(batch));
+        UTEST_REQUIRE_NOTHROW(sfunction.batch(batch));
+
+        vector_t gx(function.size()), sgx(function.size());
+        UTEST_CHECK_CLOSE(sfunction.vgrad(x, &sgx), function.vgrad(x, &gx), epsilon1<scalar_t>());
+        UTEST_CHECK_EIGEN_CLOSE(sgx, gx, epsilon1<scalar_t>());
+
+        UTEST_CHECK_CLOSE(sfunction.partial_vgrad(x, subset, &sgx), function.partial_vgrad(x, subset, &gx), epsilon1<scalar_t>());
+        UTEST_CHECK_EIGEN_CLOSE(sgx, gx, epsilon1<scalar_t>());
+    }
+
+    // NB: check the gradient with truly sparse inputs
+    const auto sdataset3 = make_sparse_dataset(dataset, 3);
+    auto sfunction3 = linear_function_t{*loss, sdataset3, samples};
+    UTEST_REQUIRE_NOTHROW(sfunction3.vAreg(5e-1));
+    UTEST_CHECK_LESS(sfunction3.grad_accuracy(x), 10 * epsilon2<scalar_t>());
+
+    // NB: the linear model should be fitted and evaluated directly on the sparse inputs
+    const auto solver = make_solver("lbfgs", epsilon3<scalar_t>());
+    const auto tdataset = make_dataset(3, 2);
+    const auto stdataset = make_sparse_dataset(tdataset);
+
+    auto model = linear_model_t{};
+    UTEST_REQUIRE_NOTHROW(model.fit(*loss, stdataset, samples, *solver));
+    UTEST_CHECK_EIGEN_CLOSE(model.bias().vector(), tdataset.bias(), 1e+2 * solver->epsilon());
+    UTEST_CHECK_EIGEN_CLOSE(model.weights().matrix(), tdataset.weights(), 1e+2 * solver->epsilon());
+
+    const auto outputs = model.predict(stdataset, samples);
+    UTEST_CHECK_EIGEN_CLOSE(outputs.vector(), model.predict(tdataset, samples).vector(), epsilon1<scalar_t>());
+}
+
 UTEST_END_MODULE()
@@ -11,7 +11,7 @@ struct loss_function_t final : public function_t
 {
     loss_function_t(const rloss_t& loss, const tensor_size_t xmaps) :
         function_t("loss", 3 * xmaps, convexity::no),
-        m_loss(loss), m_target(3, xmaps, 1, 1), m_values(3)
+        m_loss(loss), m_target(3, xmaps, 1, 1)
     {
         m_target.tensor(0) = class_target(xmaps, 11 % xmaps);
         m_target.tensor(1) = class_target(xmaps, 12 % xmaps);
@@ -31,16 +31,85 @@ struct loss_function_t final : public function_t
             UTEST_REQUIRE(gx->array().isFinite().all());
         }
 
-        m_loss->value(m_target, output, m_values.tensor());
-        UTEST_REQUIRE(m_values.array().isFinite().all());
-        return m_values.array().sum();
+        tensor1d_t values(3);
+        m_loss->value(m_target, output, values.tensor());
+        UTEST_REQUIRE(values.array().isFinite().all());
+        return values.array().sum();
+    }
+
+    void hvp(const vector_t& x, const vector_t& v, vector_t& hv) const override
+    {
+        UTEST_REQUIRE_EQUAL(x.size(), m_target.size());
+        UTEST_REQUIRE_EQUAL(v.size(), m_target.size());
+        const auto output = map_tensor(x.data(), m_target.dims());
+        const auto u = map_tensor(v.data(), m_target.dims());
+
+        hv.resize(m_target.size());
+        m_loss->hvp(m_target, output, u, map_tensor(hv.data(), m_target.dims()));
+        UTEST_REQUIRE(hv.array().isFinite().all());
     }
 
     const rloss_t&      m_loss;
     tensor4d_t          m_target;
-    mutable tensor1d_t  m_values;
 };
 
+// scalar reference implementations of the logistic and the class negative log-likelihood losses
+static scalar_t logistic_value(const tensor1d_cmap_t& target, const tensor1d_cmap_t& output)
+{
+    scalar_t value = 0.0;
+    for (tensor_size_t i = 0, size = target.size(); i < size; ++ i)
+    {
+        const auto x = -target(i) * output(i);
+        value += (x < 1.0) ? std::log1p(std::exp(x)) : (x + std::log1p(std::exp(-x)));
+    }
+    return value;
+}
+
+static void logistic_vgrad(const tensor1d_cmap_t& target, const tensor1d_cmap_t& output, tensor1d_map_t vgrad)
+{
+    for (tensor_size_t i = 0, size = target.size(); i < size; ++ i)
+    {
+        const auto x = -target(i) * output(i);
+        const auto g = (x < 1.0) ? (std::exp(x) / (1.0 + std::exp(x))) : (1.0 / (1.0 + std::exp(-x)));
+        vgrad(i) = -target(i) * g;
+    }
+}
+
+static scalar_t classnll_value(const tensor1d_cmap_t& target, const tensor1d_cmap_t& output)
+{
+    const auto omax = output.max();
+
+    scalar_t value = 0, posum = 0;
+    for (tensor_size_t i = 0, size = target.size(); i < size; ++ i)
+    {
+        value += std::exp(output(i) - omax);
+        if (is_pos_target(target(i)))
+        {
+            posum += output(i);
+        }
+    }
+    return std::log(value) - posum + omax;
+}
+
+static void classnll_vgrad(const tensor1d_cmap_t& target, const tensor1d_cmap_t& output, tensor1d_map_t vgrad)
+{
+    const auto omax = output.max();
+
+    scalar_t value = 0;
+    for (tensor_size_t i = 0, size = target.size(); i < size; ++ i)
+    {
+        value += (vgrad(i) = std::exp(output(i) - omax));
+    }
+    for (tensor_size_t i = 0, size = target.size(); i < size; ++ i)
+    {
+        vgrad(i) /= value;
+        if (is_pos_target(target(i)))
+        {
+            vgrad(i) -= 1.0;
+        }
+    }
+}
+
 UTEST_BEGIN_MODULE(test_loss)
 
 UTEST_CASE(gradient)
@@ -74,6 +143,133 @@ UTEST_CASE(gradient)
     }
 }
 
+UTEST_CASE(hvp)
+{
+    // evaluate the Hessian-vector products vs. the finite difference approximation of the gradients
+    for (const auto& loss_id : {"squared", "cauchy", "s-logistic", "m-logistic", "s-classnll",
+        "s-exponential", "m-exponential", "s-savage", "m-tangent"})
+    {
+        std::cout << "evaluating loss <" << loss_id << ">...\n";
+        for (tensor_size_t cmd_dims = 2; cmd_dims <= 5; ++ cmd_dims)
+        {
+            const auto loss = loss_t::all().get(loss_id);
+            const auto function = loss_function_t(loss, cmd_dims);
+
+            for (auto trial = 0; trial < 10; ++ trial)
+            {
+                const vector_t x = vector_t::Random(function.size());
+                const vector_t v = vector_t::Random(function.size());
+
+                vector_t hv, hv_expected;
+                function.function_t::hvp(x, v, hv_expected);
+                UTEST_REQUIRE_NOTHROW(function.hvp(x, v, hv));
+                UTEST_CHECK_EIGEN_CLOSE(hv, hv_expected, 1e-9);
+
+                UTEST_REQUIRE_NOTHROW(function.hvp(x, vector_t::Zero(function.size()), hv));
+                UTEST_CHECK_EIGEN_CLOSE(hv, vector_t::Zero(function.size()), 1e-15);
+            }
+        }
+    }
+}
+
+UTEST_CASE(value_vgrad)
+{
+    // the fused loss value and gradient should match the separate computations
+    for (const auto& loss_id : loss_t::all().ids())
+    {
+        std::cout << "evaluating loss <" << loss_id << ">...\n";
+        const auto loss = loss_t::all().get(loss_id);
+        UTEST_REQUIRE(loss);
+
+        for (tensor_size_t tsize = 1; tsize <= 5; ++ tsize)
+        {
+            tensor4d_t target(7, tsize, 1, 1);
+            for (tensor_size_t sample = 0; sample < target.size<0>(); ++ sample)
+            {
+                target.tensor(sample) = class_target(tsize, sample % tsize);
+            }
+
+            const auto max_power = (loss_id == "m-exponential" || loss_id == "s-exponential") ? 5 : 20;
+            for (int power = 0; power <= max_power; power += 5)
+            {
+                tensor4d_t output(target.dims());
+                output.random();
+                output.array() *= std::pow(std::exp(1.0), power);
+
+                tensor1d_t values, fvalues;
+                tensor4d_t vgrads, fvgrads;
+                loss->value(target, output, values);
+                loss->vgrad(target, output, vgrads);
+                loss->value_vgrad(target, output, fvalues, fvgrads);
+
+                UTEST_CHECK_EQUAL(fvalues.dims(), values.dims());
+                UTEST_CHECK_EQUAL(fvgrads.dims(), vgrads.dims());
+                UTEST_CHECK_EIGEN_CLOSE(fvalues.vector(), values.vector(), epsilon1<scalar_t>());
+                UTEST_CHECK_EIGEN_CLOSE(fvgrads.vector(), vgrads.vector(), epsilon1<scalar_t>());
+            }
+        }
+    }
+}
+
+UTEST_CASE(branch_free)
+{
+    // the branch-free array implementations should match the scalar reference implementations
+    for (const auto& loss_id : {"s-logistic", "m-logistic", "s-classnll"})
+    {
+        std::cout << "evaluating loss <" << loss_id << ">...\n";
+        const auto loss = loss_t::all().get(loss_id);
+        UTEST_REQUIRE(loss);
+
+        const auto is_logistic = string_t{loss_id}.find("logistic") != string_t::npos;
+
+        for (const tensor_size_t tsize : {1, 2, 7, 100})
+        {
+            tensor4d_t target(11, tsize, 1, 1);
+            for (tensor_size_t sample = 0; sample < target.size<0>(); ++ sample)
+            {
+                target.tensor(sample) = class_target(tsize, sample % tsize);
+            }
+
+            for (int power = 0; power <= 20; power += 4)
+            {
+                tensor4d_t output(target.dims());
+                output.random();
+                output.array() *= std::pow(std::exp(1.0), power);
+
+                tensor1d_t values, fvalues;
+                tensor4d_t vgrads, fvgrads;
+                loss->value(target, output, values);
+                loss->vgrad(target, output, vgrads);
+                loss->value_vgrad(target, output, fvalues, fvgrads);
+
+                tensor1d_t evgrad(tsize);
+                for (tensor_size_t sample = 0; sample < target.size<0>(); ++ sample)
+                {
+                    const auto starget = target.reshape(target.size<0>(), -1).tensor(sample);
+                    const auto soutput = output.reshape(target.size<0>(), -1).tensor(sample);
+
+                    auto evalue = scalar_t(0);
+                    if (is_logistic)
+                    {
+                        evalue = logistic_value(starget, soutput);
+                        logistic_vgrad(starget, soutput, evgrad.tensor());
+                    }
+                    else
+                    {
+                        evalue = classnll_value(starget, soutput);
+                        classnll_vgrad(starget, soutput, evgrad.tensor());
+                    }
+
+                    UTEST_CHECK_CLOSE(values(sample), evalue, epsilon1<scalar_t>());
+                    UTEST_CHECK_CLOSE(fvalues(sample), evalue, epsilon1<scalar_t>());
+                    UTEST_CHECK_EIGEN_CLOSE(vgrads.vector(sample), evgrad.vector(), epsilon1<scalar_t>());
+                    UTEST_CHECK_EIGEN_CLOSE(fvgrads.vector(sample), evgrad.vector(), epsilon1<scalar_t>());
+                }
+            }
+        }
+    }
+}
+
 UTEST_CASE(single_class)
 {
     for (const auto& loss_id : loss_t::all().ids(std::regex("s-.+")))
@@ -2,6 +2,8 @@
 #include <utest/utest.h>
 #include <nano/solver.h>
 #include <nano/numeric.h>
+#include <nano/function/sphere.h>
+#include <nano/solver/function.h>
 #include <nano/lsearchk/fletcher.h>
 #include <nano/lsearchk/backtrack.h>
 #include <nano/lsearchk/cgdescent.h>
@@ -79,6 +81,12 @@ static void test(
     UTEST_CHECK(lsearch.get(state, t0));
     UTEST_CHECK(state);
 
+    // check the gradient is evaluated at the returned step length (some trials may evaluate only the function value)
+    vector_t g(x0.size());
+    UTEST_CHECK(state.m_has_grad);
+    UTEST_CHECK_CLOSE(function.vgrad(state.x, &g), state.f, epsilon0<scalar_t>());
+    UTEST_CHECK_EIGEN_CLOSE(state.g, g, epsilon0<scalar_t>());
+
     switch (type)
     {
     case lsearch_type::backtrack:
@@ -154,6 +162,27 @@ UTEST_CASE(backtrack)
     }
 }
 
+UTEST_CASE(backtrack_value_only)
+{
+    const auto function = function_sphere_t{4};
+    const auto sfunction = solver_function_t{function, 0};
+
+    auto state0 = solver_state_t{sfunction, vector_t{vector_t::Random(4)}};
+    state0.d = -1000 * state0.g;
+
+    auto lsearch = lsearchk_backtrack_t{};
+    config_lsearch(lsearch);
+    UTEST_REQUIRE_NOTHROW(lsearch.interp(lsearch_step_t::interpolation::bisection));
+
+    auto state = state0;
+    UTEST_CHECK(static_cast<lsearchk_t&>(lsearch).get(state, 1.0));
+    UTEST_CHECK(state.has_armijo(state0, lsearch.c1()));
+
+    // NB: the gradient is evaluated only at the initial point, the first two trials and the returned step length
+    UTEST_CHECK_GREATER(sfunction.fcalls(), 6);
+    UTEST_CHECK_EQUAL(sfunction.gcalls(), 4);
+}
+
 UTEST_CASE(lemarechal)
 {
     const auto *const lsearch_id = "lemarechal";
@@ -261,4 +261,43 @@ UTEST_CASE(stacking)
     UTEST_CHECK_EIGEN_CLOSE(stacking_function_t::as_weights(state.x), weights, 1e+1 * solver->epsilon());
 }
 
+UTEST_CASE(stacking_partial)
+{
+    const auto loss = make_loss();
+
+    auto targets = tensor4d_t(100, 4, 4, 3);
+    auto outputs = tensor5d_t(3, 100, 4, 4, 3);
+
+    targets.random();
+    outputs.random();
+
+    const auto subset = indices_t{make_dims(4), {71, 3, 4, 50}};
+
+    auto stargets = tensor4d_t(subset.size(), 4, 4, 3);
+    auto soutputs = tensor5d_t(3, subset.size(), 4, 4, 3);
+    for (tensor_size_t i = 0; i < subset.size(); ++ i)
+    {
+        stargets.vector(i) = targets.vector(subset(i));
+        for (tensor_size_t model = 0; model < 3; ++ model)
+        {
+            soutputs.vector(model, i) = outputs.vector(model, subset(i));
+        }
+    }
+
+    auto function = stacking_function_t{*loss, targets, outputs};
+    auto sfunction = stacking_function_t{*loss, stargets, soutputs};
+    UTEST_CHECK_EQUAL(function.summands(), 100);
+
+    for (tensor_size_t batch = 1; batch <= 5; ++ batch)
+    {
+        UTEST_REQUIRE_NOTHROW(function.batch(batch));
+
+        const vector_t x = vector_t::Random(function.size());
+
+        vector_t gx(x.size()), gx_expected(x.size());
+        UTEST_CHECK_CLOSE(function.partial_vgrad(x, subset, &gx), sfunction.vgrad(x, &gx_expected), 1e-12);
+        UTEST_CHECK_EIGEN_CLOSE(gx, gx_expected, 1e-12);
+    }
+}
+
 UTEST_END_MODULE()
@@ -26,6 +26,11 @@ public:
         assert(false);
         return tensor4d_t{};
     }
+
+    void predict(const dataset_t&, const indices_cmap_t&, tensor4d_map_t) const override
+    {
+        assert(false);
+    }
 };
 
 static void check_equal(const model_param_t& param, const model_param_t& xparam)
@@ -1,7 +1,10 @@
 #include <iomanip>
 #include <utest/utest.h>
+#include <nano/tpool.h>
 #include <nano/numeric.h>
+#include <nano/solver/lbfgs.h>
 #include <nano/solver/quasi.h>
+#include <nano/solver/function.h>
 #include <nano/function/sphere.h>
 
 using namespace nano;
@@ -145,6 +148,64 @@ UTEST_CASE(state_convergence1)
     UTEST_CHECK_LESS(state.convergence_criterion(), epsilon2<scalar_t>());
 }
 
+UTEST_CASE(function_cache)
+{
+    const auto function = function_sphere_t{4};
+    const auto sfunction = solver_function_t{function, 2};
+
+    const vector_t x0 = vector_t::Random(4);
+    const vector_t x1 = vector_t::Random(4);
+    const vector_t x2 = vector_t::Random(4);
+
+    vector_t g0(4), g1(4);
+    const auto f0 = function.vgrad(x0, &g0);
+    const auto f1 = function.vgrad(x1, &g1);
+
+    vector_t gx(4);
+
+    // the function value is evaluated, but the gradient is not cached yet
+    UTEST_CHECK_CLOSE(sfunction.vgrad(x0), f0, 1e-12);
+    UTEST_CHECK_CLOSE(sfunction.vgrad(x0), f0, 1e-12);
+    UTEST_CHECK_CLOSE(sfunction.vgrad(x0, &gx), f0, 1e-12);
+    UTEST_CHECK_EIGEN_CLOSE(gx, g0, 1e-12);
+    UTEST_CHECK_EQUAL(sfunction.hits(), 1);
+    UTEST_CHECK_EQUAL(sfunction.misses(), 2);
+    UTEST_CHECK_EQUAL(sfunction.fcalls(), 2);
+    UTEST_CHECK_EQUAL(sfunction.gcalls(), 1);
+
+    // both the function value and the gradient are served from the cache
+    gx.setZero();
+    UTEST_CHECK_CLOSE(sfunction.vgrad(x0, &gx), f0, 1e-12);
+    UTEST_CHECK_EIGEN_CLOSE(gx, g0, 1e-12);
+    UTEST_CHECK_CLOSE(sfunction.vgrad(x0), f0, 1e-12);
+    UTEST_CHECK_EQUAL(sfunction.hits(), 3);
+    UTEST_CHECK_EQUAL(sfunction.misses(), 2);
+
+    // the least recently used point is evicted
+    UTEST_CHECK_CLOSE(sfunction.vgrad(x1, &gx), f1, 1e-12);
+    UTEST_CHECK_EIGEN_CLOSE(gx, g1, 1e-12);
+    UTEST_CHECK_CLOSE(sfunction.vgrad(x0), f0, 1e-12);
+    UTEST_CHECK_CLOSE(sfunction.vgrad(x2), function.vgrad(x2, nullptr), 1e-12);
+    UTEST_CHECK_EQUAL(sfunction.hits(), 4);
+    UTEST_CHECK_EQUAL(sfunction.misses(), 4);
+
+    UTEST_CHECK_CLOSE(sfunction.vgrad(x0), f0, 1e-12);
+    UTEST_CHECK_CLOSE(sfunction.vgrad(x1), f1, 1e-12);
+    UTEST_CHECK_EQUAL(sfunction.hits(), 5);
+    UTEST_CHECK_EQUAL(sfunction.misses(), 5);
+    UTEST_CHECK_EQUAL(sfunction.fcalls(), 5);
+    UTEST_CHECK_EQUAL(sfunction.gcalls(), 2);
+
+    // the memoization doesn't change the optimization trajectory
+    const auto solver = solver_t::all().get("lbfgs");
+    UTEST_REQUIRE(solver);
+
+    const auto state = solver->minimize(function, x0);
+    UTEST_CHECK_EQUAL(state.m_fcalls, state.m_misses);
+    UTEST_CHECK_GREATER_EQUAL(state.m_hits, 0);
+    UTEST_CHECK(state.converged(solver->epsilon()));
+}
+
 UTEST_CASE(config_solvers)
 {
     for (const auto& solver_id : solver_t::all().ids())
@@ -186,7 +247,18 @@ UTEST_CASE(config_solvers)
 const auto all_functions = get_functions(4, 4, convexity::unknown);
 const auto convex_functions = get_functions(4, 4, convexity::yes);
 
-const auto all_solver_ids = solver_t::all().ids();
+static auto make_solver_ids()
+{
+    // NB: the stochastic solvers are excluded as they are tested on sample-decomposable functions (see test_linear)
+    auto ids = solver_t::all().ids();
+    ids.erase(std::remove_if(ids.begin(), ids.end(), [] (const auto& id)
+    {
+        return id == "sgd" || id == "adam" || id == "svrg";
+    }), ids.end());
+    return ids;
+}
+
+const auto all_solver_ids = make_solver_ids();
 const auto best_solver_ids = solver_t::all().ids(std::regex("cgd|lbfgs|bfgs"));
 const auto all_lsearch0_ids = lsearch0_t::all().ids();
 const auto all_lsearchk_ids = lsearchk_t::all().ids();
@@ -209,6 +281,10 @@ UTEST_CASE(all_default_solvers)
 
 UTEST_CASE(best_solvers_with_lsearches)
 {
+    // NB: restart the pseudo-random starting points (as at program start),
+    //  so that they don't depend on the solvers tested by the previous cases
+    std::srand(1);
+
     for (const auto& function : all_functions)
     {
         UTEST_REQUIRE(function);
@@ -284,4 +360,192 @@ UTEST_CASE(quasi_with_initializations)
     }
 }
 
+UTEST_CASE(lbfgs_with_representations)
+{
+    for (const auto& function : convex_functions)
+    {
+        UTEST_REQUIRE(function);
+
+        const auto x0 = vector_t{vector_t::Random(function->size())};
+        for (const size_t history : {1, 3, 6})
+        {
+            auto solver_recursive = solver_lbfgs_t{};
+            UTEST_REQUIRE_NOTHROW(solver_recursive.history(history));
+            UTEST_REQUIRE_NOTHROW(solver_recursive.repr(solver_lbfgs_t::representation::recursive));
+
+            auto solver_compact = solver_lbfgs_t{};
+            UTEST_REQUIRE_NOTHROW(solver_compact.history(history));
+            UTEST_REQUIRE_NOTHROW(solver_compact.repr(solver_lbfgs_t::representation::compact));
+
+            // NB: the two representations are mathematically equivalent
+            const auto state_recursive = solver_recursive.minimize(*function, x0);
+            const auto state_compact = solver_compact.minimize(*function, x0);
+            UTEST_CHECK_EQUAL(state_compact.m_iterations, state_recursive.m_iterations);
+            UTEST_CHECK_EIGEN_CLOSE(state_compact.x, state_recursive.x, epsilon2<scalar_t>());
+
+            test(solver_recursive, "lbfgs", *function, x0);
+            test(solver_compact, "lbfgs", *function, x0);
+        }
+    }
+}
+
+UTEST_CASE(minimize_many)
+{
+    for (const auto& function : convex_functions)
+    {
+        UTEST_REQUIRE(function);
+
+        const auto solver = solver_t::all().get("lbfgs");
+        UTEST_REQUIRE(solver);
+
+        std::vector<vector_t> x0s;
+        for (size_t i = 0; i < 2 * tpool_t::size() + 1; ++ i)
+        {
+            x0s.emplace_back(vector_t::Random(function->size()));
+        }
+
+        // all minimizations should converge and the states should be sorted by the function value
+        const auto states = solver->minimize_many(*function, x0s);
+        UTEST_REQUIRE_EQUAL(states.size(), x0s.size());
+        UTEST_CHECK(std::is_sorted(states.begin(), states.end()));
+        for (const auto& state : states)
+        {
+            UTEST_CHECK(state);
+            UTEST_CHECK(state.m_status == solver_state_t::status::converged);
+        }
+
+        // the target function value is reached right away, so all minimizations should be stopped
+        const auto stopped_states = solver->minimize_many(*function, x0s, std::numeric_limits<scalar_t>::max());
+        UTEST_REQUIRE_EQUAL(stopped_states.size(), x0s.size());
+        UTEST_CHECK(std::is_sorted(stopped_states.begin(), stopped_states.end()));
+        for (const auto& state : stopped_states)
+        {
+            UTEST_CHECK(state.m_status == solver_state_t::status::stopped);
+            UTEST_CHECK_LESS_EQUAL(state.m_iterations, 1);
+        }
+    }
+}
+
+UTEST_CASE(bounds_unconstrained)
+{
+    for (const auto& function : convex_functions)
+    {
+        UTEST_REQUIRE(function);
+
+        const auto solver = solver_t::all().get("lbfgsb");
+        UTEST_REQUIRE(solver);
+
+        test(*solver, "lbfgsb", *function, vector_t::Random(function->size()));
+    }
+}
+
+UTEST_CASE(bounds_invalid)
+{
+    const auto function = function_sphere_t{4};
+    const vector_t x0 = vector_t::Random(4);
+
+    const auto lbfgs = solver_t::all().get("lbfgs");
+    const auto lbfgsb = solver_t::all().get("lbfgsb");
+    UTEST_REQUIRE(lbfgs);
+    UTEST_REQUIRE(lbfgsb);
+    UTEST_CHECK(!lbfgs->bounded());
+    UTEST_CHECK(lbfgsb->bounded());
+
+    const vector_t lower = vector_t::Constant(4, -1.0);
+    const vector_t upper = vector_t::Constant(4, +1.0);
+
+    UTEST_CHECK_THROW(lbfgs->minimize(function, x0, lower, upper), std::runtime_error);
+    UTEST_CHECK_THROW(lbfgsb->minimize(function, x0, upper, lower), std::runtime_error);
+    UTEST_CHECK_THROW(lbfgsb->minimize(function, x0, lower.head(3), upper), std::runtime_error);
+    UTEST_CHECK_NOTHROW(lbfgsb->minimize(function, x0, lower, upper));
+}
+
+UTEST_CASE(bounds_sphere)
+{
+    const auto function = function_sphere_t{7};
+
+    const auto solver = solver_t::all().get("lbfgsb");
+    UTEST_REQUIRE(solver);
+
+    for (auto trial = 0; trial < 10; ++ trial)
+    {
+        // NB: the solution is the projection of the origin onto the feasible box
+        const vector_t lower = vector_t::Random(7) - vector_t::Constant(7, 0.5);
+        const vector_t upper = lower + vector_t::Random(7).cwiseAbs();
+        const vector_t xbest = vector_t::Zero(7).cwiseMax(lower).cwiseMin(upper);
+
+        const auto state = solver->minimize(function, vector_t::Random(7) * 5.0, lower, upper);
+        UTEST_CHECK(state);
+        UTEST_CHECK(state.m_status == solver_state_t::status::converged);
+        UTEST_CHECK_EIGEN_CLOSE(state.x, xbest, 1e+1 * solver->epsilon());
+    }
+}
+
+UTEST_CASE(bounds_convex)
+{
+    for (const auto& function : convex_functions)
+    {
+        UTEST_REQUIRE(function);
+
+        const auto solver = solver_t::all().get("lbfgsb");
+        UTEST_REQUIRE(solver);
+
+        solver->epsilon(1e-6);
+        solver->max_iterations(10000);
+
+        const auto n = function->size();
+        const vector_t lower = vector_t::Random(n) * 0.5 - vector_t::Constant(n, 0.5);
+        const vector_t upper = lower + vector_t::Constant(n, 0.5);
+
+        const auto state = solver->minimize(*function, vector_t::Random(n), lower, upper);
+        UTEST_CHECK(state);
+        UTEST_CHECK(state.m_status == solver_state_t::status::converged);
+
+        // check feasibility
+        UTEST_CHECK_GREATER_EQUAL((state.x - lower).minCoeff(), 0.0);
+        UTEST_CHECK_GREATER_EQUAL((upper - state.x).minCoeff(), 0.0);
+
+        // check optimality: the projected gradient is zero
+        const vector_t pg = (state.x - state.g).cwiseMax(lower).cwiseMin(upper) - state.x;
+        UTEST_CHECK_LESS(pg.lpNorm<Eigen::Infinity>() / std::max(1.0, std::fabs(state.f)), solver->epsilon());
+    }
+}
+
+UTEST_CASE(telemetry)
+{
+    const auto function = function_sphere_t{7};
+
+    for (const auto& solver_id : {"gd", "cgd", "lbfgs", "bfgs", "newton"})
+    {
+        const auto solver = solver_t::all().get(solver_id);
+        UTEST_REQUIRE(solver);
+
+        tensor_size_t iterations = 0;
+        solver_state_t lstate;
+        solver->logger([&] (const solver_state_t& state)
+        {
+            // NB: the cost is cumulated with each iteration
+            UTEST_CHECK_GREATER_EQUAL(state.m_time, lstate.m_time);
+            UTEST_CHECK_GREATER_EQUAL(state.m_ftime, lstate.m_ftime);
+            UTEST_CHECK_GREATER_EQUAL(state.m_ltime, lstate.m_ltime);
+            UTEST_CHECK_GREATER_EQUAL(state.m_dtime, lstate.m_dtime);
+            UTEST_CHECK_GREATER_EQUAL(state.m_fbytes, lstate.m_fbytes);
+            lstate = state;
+            ++ iterations;
+            return true;
+        });
+
+        const auto state = solver->minimize(function, vector_t::Ones(7));
+        UTEST_CHECK(state.m_status == solver_state_t::status::converged);
+        UTEST_CHECK_GREATER(iterations, 1);
+
+        UTEST_CHECK_GREATER(state.m_ftime, 0);
+        UTEST_CHECK_GREATER(state.m_ltime, 0);
+        UTEST_CHECK_GREATER(state.m_dtime, 0);
+        UTEST_CHECK_GREATER_EQUAL(state.m_time, state.m_ftime);
+        UTEST_CHECK_GREATER_EQUAL(state.m_time, state.m_ltime + state.m_dtime);
+        UTEST_CHECK_EQUAL(state.m_fbytes, state.m_fcalls * function.bytes() + state.m_hcalls * function.hvp_bytes());
+    }
+}
+
 UTEST_END_MODULE()
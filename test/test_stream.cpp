@@ -167,6 +167,24 @@ UTEST_CASE(serializable_read_patch)
     UTEST_CHECK_EQUAL(object.patch_version(), ::nano::patch_version - 3);
 }
 
+UTEST_CASE(serializable_since)
+{
+    auto object = serializable_t{};
+
+    auto str = to_string(object);
+    reinterpret_cast<int32_t*>(const_cast<char*>(str.data()))[2] = ::nano::patch_version - 1; // NOLINT
+
+    std::istringstream stream(str);
+    UTEST_REQUIRE_NOTHROW(object.read(stream));
+
+    UTEST_CHECK(object.serialized_since(::nano::major_version - 1, ::nano::minor_version + 1, ::nano::patch_version + 1));
+    UTEST_CHECK(object.serialized_since(::nano::major_version, ::nano::minor_version - 1, ::nano::patch_version + 1));
+    UTEST_CHECK(object.serialized_since(::nano::major_version, ::nano::minor_version, ::nano::patch_version - 1));
+    UTEST_CHECK(!object.serialized_since(::nano::major_version, ::nano::minor_version, ::nano::patch_version));
+    UTEST_CHECK(!object.serialized_since(::nano::major_version, ::nano::minor_version + 1, ::nano::patch_version - 1));
+    UTEST_CHECK(!object.serialized_since(::nano::major_version + 1, ::nano::minor_version - 1, ::nano::patch_version - 1));
+}
+
 UTEST_CASE(serializable_write_fail)
 {
     const auto object = serializable_t{};
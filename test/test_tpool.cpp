@@ -167,4 +167,28 @@ UTEST_CASE(loopr)
     }
 }
 
+UTEST_CASE(nested)
+{
+    const auto size = size_t(37);
+    const auto op = [] (const size_t i) { return std::cos(i); };
+
+    const auto eps = epsilon1<double>();
+    const auto ref = test_single(size, op);
+
+    // NB: the inner loops are run sequentially by the worker threads, so the pool does not deadlock
+    std::vector<double> results(2 * tpool_t::size() + 1, 0.0);
+    nano::loopi(results.size(), [&] (const size_t i, const size_t)
+    {
+        UTEST_CHECK(tpool_worker_t::current());
+
+        results[i] = (i % 2 == 0) ? test_loopi(size, op) : test_loopr(size, 3, op);
+    });
+
+    UTEST_CHECK(!tpool_worker_t::current());
+    for (const auto result : results)
+    {
+        UTEST_CHECK_CLOSE(ref, result, eps);
+    }
+}
+
 UTEST_END_MODULE()